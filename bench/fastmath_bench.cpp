@@ -0,0 +1,141 @@
+#include "../include/FastMath.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+// ============================================================================
+// FAST MATH BENCHMARK
+// Throughput of libm vs FastMath over large SoA-style arrays, and the largest
+// error of both against a double-precision libm reference.
+// ============================================================================
+
+namespace {
+
+constexpr size_t SAMPLE_COUNT = 1 << 20;
+constexpr int REPETITIONS = 20;
+
+enum class ErrorKind { ABSOLUTE, RELATIVE };
+
+struct Result {
+    double calls_per_us;
+    double max_error;
+};
+
+// Time `fn` over every sample; `sink` keeps the optimizer from dropping work
+template <typename Fn>
+double MeasureThroughput(const std::vector<float>& a, const std::vector<float>& b,
+                         std::vector<float>& out, Fn fn) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            out[i] = fn(a[i], b[i]);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    return (static_cast<double>(a.size()) * REPETITIONS) / us;
+}
+
+template <typename Ref>
+double MaxError(const std::vector<float>& a, const std::vector<float>& b,
+                const std::vector<float>& out, Ref reference, ErrorKind kind) {
+    double worst = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        double expected = reference(static_cast<double>(a[i]), static_cast<double>(b[i]));
+        double error = std::abs(static_cast<double>(out[i]) - expected);
+        if (kind == ErrorKind::RELATIVE && expected != 0.0) error /= std::abs(expected);
+        worst = std::max(worst, error);
+    }
+    return worst;
+}
+
+template <typename Lib, typename Fast, typename Ref>
+void Benchmark(const std::string& name, const std::vector<float>& a, const std::vector<float>& b,
+               Lib lib, Fast fast, Ref reference, ErrorKind kind) {
+    std::vector<float> out(a.size());
+
+    Result lib_result;
+    lib_result.calls_per_us = MeasureThroughput(a, b, out, lib);
+    lib_result.max_error = MaxError(a, b, out, reference, kind);
+
+    Result fast_result;
+    fast_result.calls_per_us = MeasureThroughput(a, b, out, fast);
+    fast_result.max_error = MaxError(a, b, out, reference, kind);
+
+    std::cout << std::left << std::setw(8) << name
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << lib_result.calls_per_us
+              << std::setw(12) << fast_result.calls_per_us
+              << std::setw(9) << fast_result.calls_per_us / lib_result.calls_per_us << "x"
+              << std::scientific << std::setprecision(2)
+              << std::setw(12) << lib_result.max_error
+              << std::setw(12) << fast_result.max_error
+              << "  " << (kind == ErrorKind::RELATIVE ? "rel" : "abs") << std::endl;
+}
+
+std::vector<float> Uniform(std::mt19937& rng, float lo, float hi) {
+    std::uniform_real_distribution<float> dist(lo, hi);
+    std::vector<float> values(SAMPLE_COUNT);
+    for (float& v : values) v = dist(rng);
+    return values;
+}
+
+// Positive values spread log-uniformly across the float range
+std::vector<float> LogUniform(std::mt19937& rng, float lo_exp, float hi_exp) {
+    std::uniform_real_distribution<float> dist(lo_exp, hi_exp);
+    std::vector<float> values(SAMPLE_COUNT);
+    for (float& v : values) v = std::pow(2.0f, dist(rng));
+    return values;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(1234);
+
+    std::cout << "=== FAST MATH BENCHMARK (" << SAMPLE_COUNT << " samples x "
+              << REPETITIONS << ") ===" << std::endl;
+    std::cout << "Throughput in calls/us; error vs double-precision libm" << std::endl;
+    std::cout << std::left << std::setw(8) << "func"
+              << std::right << std::setw(12) << "libm" << std::setw(12) << "fast"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "libm err" << std::setw(12) << "fast err" << std::endl;
+
+    std::vector<float> unused(SAMPLE_COUNT, 0.0f);
+    std::vector<float> positive = LogUniform(rng, -60.0f, 60.0f);
+    std::vector<float> coords_y = Uniform(rng, -1000.0f, 1000.0f);
+    std::vector<float> coords_x = Uniform(rng, -1000.0f, 1000.0f);
+    std::vector<float> angles = Uniform(rng, -10000.0f, 10000.0f);
+    std::vector<float> exponents = Uniform(rng, -87.0f, 88.0f);
+
+    Benchmark("rsqrt", positive, unused,
+              [](float x, float) { return 1.0f / std::sqrt(x); },
+              [](float x, float) { return FastMath::Rsqrt(x); },
+              [](double x, double) { return 1.0 / std::sqrt(x); }, ErrorKind::RELATIVE);
+    Benchmark("sqrt", positive, unused,
+              [](float x, float) { return std::sqrt(x); },
+              [](float x, float) { return FastMath::Sqrt(x); },
+              [](double x, double) { return std::sqrt(x); }, ErrorKind::RELATIVE);
+    Benchmark("atan2", coords_y, coords_x,
+              [](float y, float x) { return std::atan2(y, x); },
+              [](float y, float x) { return FastMath::Atan2(y, x); },
+              [](double y, double x) { return std::atan2(y, x); }, ErrorKind::ABSOLUTE);
+    Benchmark("sin", angles, unused,
+              [](float x, float) { return std::sin(x); },
+              [](float x, float) { return FastMath::Sin(x); },
+              [](double x, double) { return std::sin(x); }, ErrorKind::ABSOLUTE);
+    Benchmark("cos", angles, unused,
+              [](float x, float) { return std::cos(x); },
+              [](float x, float) { return FastMath::Cos(x); },
+              [](double x, double) { return std::cos(x); }, ErrorKind::ABSOLUTE);
+    Benchmark("exp", exponents, unused,
+              [](float x, float) { return std::exp(x); },
+              [](float x, float) { return FastMath::Exp(x); },
+              [](double x, double) { return std::exp(x); }, ErrorKind::RELATIVE);
+
+    return 0;
+}
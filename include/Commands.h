@@ -0,0 +1,340 @@
+#pragma once
+
+#include "Components.h"
+#include "Systems.h"
+#include "Diagnostics.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+// ============================================================================
+// COMMANDS - "The Mailbox"
+// Outside threads (network frontends, scripted events) post commands into
+// bounded lock-free queues and never touch the GameState. The simulation
+// drains every queue at one fixed point in the frame, sorts the batch by
+// entity so it walks the arrays once, front to back, and applies it. A full
+// queue rejects the command at once and counts it; nothing grows.
+// ============================================================================
+
+namespace Commands {
+
+enum class CommandType : uint8_t {
+    SPAWN = 0, // New entity at (x, y)
+    TELEPORT,  // Move `entity` to (x, y)
+    SET_NEED   // Set one of `entity`'s needs to `value`
+};
+
+enum class Need : uint8_t {
+    HUNGER = 0,
+    ENERGY,
+    SAFETY,
+    CURIOSITY
+};
+
+struct Command {
+    CommandType type = CommandType::SPAWN;
+    Need need = Need::HUNGER;
+    EntityID entity = INVALID_ENTITY; // INVALID_ENTITY for SPAWN, so spawns sort last
+    float x = 0.0f;
+    float y = 0.0f;
+    float value = 0.0f;
+    
+    static Command Spawn(float x, float y) {
+        Command command;
+        command.type = CommandType::SPAWN;
+        command.x = x;
+        command.y = y;
+        return command;
+    }
+    
+    static Command Teleport(EntityID entity, float x, float y) {
+        Command command;
+        command.type = CommandType::TELEPORT;
+        command.entity = entity;
+        command.x = x;
+        command.y = y;
+        return command;
+    }
+    
+    static Command SetNeed(EntityID entity, Need need, float value) {
+        Command command;
+        command.type = CommandType::SET_NEED;
+        command.need = need;
+        command.entity = entity;
+        command.value = value;
+        return command;
+    }
+};
+
+// ============================================================================
+// COMMAND QUEUE - Bounded multi-producer, single-consumer ring
+// Each cell carries a sequence number (Vyukov's bounded queue): producers
+// claim a slot with one CAS on the tail and publish by bumping the cell's
+// sequence; the consumer reads cells in order until it meets one that is
+// not yet published. Cells are cache-line sized so producers writing
+// neighbouring slots do not share a line.
+// ============================================================================
+
+class CommandQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit CommandQueue(size_t capacity = 1024) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        cells = std::make_unique<Cell[]>(size);
+        mask = size - 1;
+        for (size_t c = 0; c < size; ++c) cells[c].sequence.store(c, std::memory_order_relaxed);
+    }
+    
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+    
+    size_t Capacity() const { return mask + 1; }
+    
+    // Any thread. False when the queue is full; the command is dropped.
+    bool Push(const Command& command) {
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const int64_t lag = static_cast<int64_t>(sequence - position);
+            if (lag == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (lag < 0) {
+                // The consumer has not freed this cell yet: a full lap behind
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->command = command;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        pushed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    
+    // Consumer only: append up to `limit` published commands, oldest first
+    size_t Drain(std::vector<Command>& out, size_t limit) {
+        size_t count = 0;
+        while (count < limit) {
+            Cell& cell = cells[head & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1) break;
+            out.push_back(cell.command);
+            cell.sequence.store(head + mask + 1, std::memory_order_release); // Free for the next lap
+            head++;
+            count++;
+        }
+        return count;
+    }
+    
+    uint64_t Pushed() const { return pushed.load(std::memory_order_relaxed); }
+    uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<uint64_t> sequence{0};
+        Command command;
+    };
+    
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail{0}; // Next slot a producer claims
+    alignas(CACHE_LINE_SIZE) uint64_t head = 0;             // Next slot the consumer reads
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> dropped{0};
+};
+
+// ============================================================================
+// COMMAND INGEST - Drains the queues into the GameState once per frame
+// Register Apply() as the frame's first stage with READS/WRITES: a spawn
+// resizes every component, so nothing may overlap it.
+// ============================================================================
+
+class CommandIngest {
+public:
+    static constexpr ComponentMask READS = ~Component::NONE;
+    static constexpr ComponentMask WRITES = ~Component::NONE;
+    
+    struct Stats {
+        uint64_t applied = 0;   // Commands that changed the state
+        uint64_t rejected = 0;  // Dead or unknown entity, blocked cell, entity cap
+        uint64_t spawned = 0;
+        uint64_t batches = 0;   // Frames that had at least one command
+        size_t max_batch = 0;
+    };
+    
+    // Spawns beyond max_entities are rejected, so the state stays bounded
+    // too. delta_time is the frame step lazily updated needs catch up with.
+    CommandIngest(size_t max_entities, float delta_time) : max_entities(max_entities), delta_time(delta_time) {}
+    
+    // Queues are drained in the order they were attached
+    void Attach(CommandQueue& queue) {
+        queues.push_back(&queue);
+        batch.reserve(batch.capacity() + queue.Capacity());
+    }
+    
+    // At most one queue's worth per queue per frame, so a flooding producer
+    // cannot stretch a frame; the rest waits for the next one
+    void Apply(GameState& state) {
+        batch.clear();
+        for (CommandQueue* queue : queues) queue->Drain(batch, queue->Capacity());
+        if (batch.empty()) return;
+        stats.batches++;
+        stats.max_batch = std::max(stats.max_batch, batch.size());
+        
+        // Stable: one entity's commands keep their posting order
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const Command& a, const Command& b) { return a.entity < b.entity; });
+        spawns.clear();
+        for (const Command& command : batch) {
+            if (ApplyOne(state, command)) {
+                stats.applied++;
+            } else {
+                stats.rejected++;
+            }
+        }
+        SpawnAll(state);
+    }
+    
+    const Stats& GetStats() const { return stats; }
+    
+    uint64_t Dropped() const {
+        uint64_t dropped = 0;
+        for (const CommandQueue* queue : queues) dropped += queue->Dropped();
+        return dropped;
+    }
+    
+    // Ingestion figures, printed with the profiler's report
+    void Publish(Diagnostics::Profiler& profiler) const {
+        profiler.SetStat("Commands applied", static_cast<double>(stats.applied));
+        profiler.SetStat("Commands rejected", static_cast<double>(stats.rejected));
+        profiler.SetStat("Commands dropped (queue full)", static_cast<double>(Dropped()));
+        profiler.SetStat("Command batch max", static_cast<double>(stats.max_batch));
+    }
+
+private:
+    size_t max_entities;
+    float delta_time;
+    std::vector<CommandQueue*> queues;
+    std::vector<Command> batch;  // Reused; sized for every queue full at once
+    std::vector<Command> spawns; // Accepted spawns, created together after the batch
+    Stats stats;
+    
+    static bool InWorld(const GameState& state, float x, float y) {
+        return x >= 0.0f && x <= 1000.0f && y >= 0.0f && y <= 1000.0f && !state.obstacles.IsBlockedAt(x, y);
+    }
+    
+    static bool Targets(const GameState& state, EntityID entity) {
+        return entity < state.entity_count && state.health.is_alive[entity];
+    }
+    
+    bool ApplyOne(GameState& state, const Command& command) {
+        switch (command.type) {
+            case CommandType::SPAWN:
+                if (state.entity_count + spawns.size() >= max_entities || !InWorld(state, command.x, command.y)) {
+                    return false;
+                }
+                spawns.push_back(command);
+                return true;
+            case CommandType::TELEPORT:
+                if (!Targets(state, command.entity) || !InWorld(state, command.x, command.y)) return false;
+                Teleport(state, command.entity, command.x, command.y);
+                return true;
+            case CommandType::SET_NEED:
+                if (!Targets(state, command.entity)) return false;
+                SetNeed(state, command.entity, command.need, command.value);
+                return true;
+        }
+        return false;
+    }
+    
+    static std::vector<float>& NeedColumn(NeedsComponents& needs, Need need) {
+        switch (need) {
+            case Need::ENERGY: return needs.energy;
+            case Need::SAFETY: return needs.safety;
+            case Need::CURIOSITY: return needs.curiosity;
+            case Need::HUNGER: break;
+        }
+        return needs.hunger;
+    }
+    
+    // The skipped frames of a lazily updated entity run with its old
+    // inputs, then the new value holds as of this frame
+    void SetNeed(GameState& state, EntityID entity, Need need, float value) const {
+        Systems::NeedsModel::Resolve(state, entity, state.frame_index - 1, delta_time);
+        NeedColumn(state.needs, need)[entity] = std::max(0.0f, std::min(1.0f, value));
+        state.needs.last_update_frame[entity] = state.frame_index;
+    }
+    
+    // One resize for the whole batch: growing the arrays per spawn would
+    // cost O(spawns * entities). Same defaults as the initial population,
+    // with middling needs.
+    void SpawnAll(GameState& state) {
+        if (spawns.empty()) return;
+        const size_t first = state.entity_count;
+        state.Resize(first + spawns.size());
+        for (size_t k = 0; k < spawns.size(); ++k) {
+            const EntityID id = static_cast<EntityID>(first + k);
+            const float x = spawns[k].x;
+            const float y = spawns[k].y;
+            auto place = [id, x, y](TransformComponents& t) {
+                t.position_x[id] = x;
+                t.position_y[id] = y;
+                t.heading_x[id] = 1.0f;
+                t.heading_y[id] = 0.0f;
+            };
+            place(state.transforms);
+            if (state.double_buffered & Component::TRANSFORMS) place(state.next_transforms);
+            state.perception.view_range[id] = 50.0f + (id % 50);
+            state.perception.view_angle[id] = M_PI / 2.0f;
+            state.perception.last_perception_frame[id] = Systems::TimeSlicing::Overdue(state);
+            state.needs.hunger[id] = 0.5f;
+            state.needs.energy[id] = 0.5f;
+            state.needs.safety[id] = 0.5f;
+            state.needs.curiosity[id] = 0.5f;
+            state.health.health[id] = 100.0f;
+            state.health.max_health[id] = 100.0f;
+            state.health.armor_type[id] = id % 3;
+            // Incremental systems start counting from the frame the entity joined
+            state.needs.last_update_frame[id] = state.frame_index - 1;
+            state.lod.last_kinetic_frame[id] = state.frame_index - 1;
+        }
+        stats.spawned += spawns.size();
+        Systems::KineticSystem::PlaceRows(state); // Growing may have moved the arrays
+    }
+    
+    // Needs are resolved first: the skipped frames happened at the old
+    // position, with its crowding and danger. The entity is perceived again
+    // this frame, and lazy motion restarts from here. Both buffers move,
+    // so the jump holds whichever one is read next. A route planned from
+    // the old position is dropped; a queued request (PENDING) is left to
+    // be served and replanned as usual.
+    void Teleport(GameState& state, EntityID entity, float x, float y) const {
+        Systems::NeedsModel::Resolve(state, entity, state.frame_index - 1, delta_time);
+        state.perception.last_perception_frame[entity] = Systems::TimeSlicing::Overdue(state);
+        state.lod.last_kinetic_frame[entity] = state.frame_index - 1;
+        state.transforms.position_x[entity] = x;
+        state.transforms.position_y[entity] = y;
+        state.transforms.velocity_x[entity] = 0.0f;
+        state.transforms.velocity_y[entity] = 0.0f;
+        if (state.double_buffered & Component::TRANSFORMS) {
+            state.next_transforms.position_x[entity] = x;
+            state.next_transforms.position_y[entity] = y;
+            state.next_transforms.velocity_x[entity] = 0.0f;
+            state.next_transforms.velocity_y[entity] = 0.0f;
+        }
+        if (state.paths.status[entity] != PathStatus::PENDING) {
+            state.paths.status[entity] = PathStatus::NONE;
+            state.paths.goal_cell[entity] = -1;
+            state.paths.cursor[entity] = 0;
+            state.paths.waypoints[entity].clear();
+        }
+    }
+};
+
+} // namespace Commands
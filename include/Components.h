@@ -1,12 +1,72 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 #include <cassert>
+#include <type_traits>
+#include <new>
+#include <unordered_map>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <atomic>
+#include <memory>
 
 // Cache line size for alignment
 constexpr size_t CACHE_LINE_SIZE = 64;
 
+// Widest SIMD register we vectorize for (8 floats = AVX). Hot arrays are
+// padded to a multiple of this so vector kernels never need a scalar tail.
+constexpr size_t SIMD_WIDTH = 8;
+
+inline size_t PaddedCount(size_t count) {
+    return (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+}
+
+// Allocator that starts every array on a cache line (and so on a SIMD boundary)
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+    
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U>&) {}
+    
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(CACHE_LINE_SIZE)));
+    }
+    
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(CACHE_LINE_SIZE));
+    }
+    
+    template <typename U> bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Counters shared by the jobs of one parallel build. Scratch only: a copy
+// starts empty, so the state that holds them stays copyable.
+struct AtomicCounters {
+    std::unique_ptr<std::atomic<uint32_t>[]> values;
+    size_t capacity = 0;
+    
+    AtomicCounters() = default;
+    AtomicCounters(const AtomicCounters&) {}
+    AtomicCounters& operator=(const AtomicCounters&) { return *this; }
+    
+    // At least `count` counters; contents are left for the caller to set
+    void Reserve(size_t count) {
+        if (count <= capacity) return;
+        values = std::make_unique<std::atomic<uint32_t>[]>(count);
+        capacity = count;
+    }
+    
+    std::atomic<uint32_t>& operator[](size_t i) { return values[i]; }
+};
+
 // Entity is just an index
 using EntityID = uint32_t;
 constexpr EntityID INVALID_ENTITY = UINT32_MAX;
@@ -16,28 +76,52 @@ constexpr EntityID INVALID_ENTITY = UINT32_MAX;
 // ============================================================================
 
 // Hot Data - Accessed every frame for movement/physics
+// Arrays are cache-line aligned and padded to SIMD_WIDTH; Size() is the
+// logical entity count.
 struct alignas(CACHE_LINE_SIZE) TransformComponents {
-    std::vector<float> position_x;
-    std::vector<float> position_y;
-    std::vector<float> position_z;
+    AlignedVector<float> position_x;
+    AlignedVector<float> position_y;
+    AlignedVector<float> position_z;
     
-    std::vector<float> velocity_x;
-    std::vector<float> velocity_y;
-    std::vector<float> velocity_z;
+    AlignedVector<float> velocity_x;
+    AlignedVector<float> velocity_y;
+    AlignedVector<float> velocity_z;
     
-    std::vector<float> orientation; // Radians
+    // Facing direction as a unit vector; radians are derived only for display
+    AlignedVector<float> heading_x;
+    AlignedVector<float> heading_y;
     
-    void Resize(size_t count) {
-        position_x.resize(count);
-        position_y.resize(count);
-        position_z.resize(count);
-        velocity_x.resize(count);
-        velocity_y.resize(count);
-        velocity_z.resize(count);
-        orientation.resize(count);
+    size_t count = 0;
+    
+    void Resize(size_t new_count) {
+        count = new_count;
+        size_t padded = PaddedCount(new_count);
+        position_x.resize(padded);
+        position_y.resize(padded);
+        position_z.resize(padded);
+        velocity_x.resize(padded);
+        velocity_y.resize(padded);
+        velocity_z.resize(padded);
+        heading_x.resize(padded, 1.0f);
+        heading_y.resize(padded);
+    }
+    
+    // Entities [begin, end) from another buffer of the same size
+    void CopyRows(const TransformComponents& from, size_t begin, size_t end) {
+        auto copy = [begin, end](const AlignedVector<float>& src, AlignedVector<float>& dst) {
+            std::copy(src.begin() + begin, src.begin() + end, dst.begin() + begin);
+        };
+        copy(from.position_x, position_x);
+        copy(from.position_y, position_y);
+        copy(from.position_z, position_z);
+        copy(from.velocity_x, velocity_x);
+        copy(from.velocity_y, velocity_y);
+        copy(from.velocity_z, velocity_z);
+        copy(from.heading_x, heading_x);
+        copy(from.heading_y, heading_y);
     }
     
-    size_t Size() const { return position_x.size(); }
+    size_t Size() const { return count; }
 };
 
 // Perception Data - What entities can "see"
@@ -45,11 +129,13 @@ struct alignas(CACHE_LINE_SIZE) PerceptionComponents {
     std::vector<float> view_range;
     std::vector<float> view_angle; // Field of view in radians
     std::vector<uint32_t> visible_entity_count;
+    std::vector<uint32_t> last_perception_frame; // Frame of last visibility query
     
     void Resize(size_t count) {
         view_range.resize(count);
         view_angle.resize(count);
         visible_entity_count.resize(count);
+        last_perception_frame.resize(count);
     }
     
     size_t Size() const { return view_range.size(); }
@@ -61,12 +147,16 @@ struct alignas(CACHE_LINE_SIZE) NeedsComponents {
     std::vector<float> energy;      // 0.0 = exhausted, 1.0 = full energy
     std::vector<float> safety;      // 0.0 = in danger, 1.0 = safe
     std::vector<float> curiosity;   // 0.0 = content, 1.0 = exploring
+    std::vector<uint8_t> danger_level;       // Influence-map danger at the entity, quantized
+    std::vector<uint32_t> last_update_frame; // Last frame whose needs step was applied
     
     void Resize(size_t count) {
         hunger.resize(count);
         energy.resize(count);
         safety.resize(count);
         curiosity.resize(count);
+        danger_level.resize(count, 0);
+        last_update_frame.resize(count, UINT32_MAX); // "Frame -1": first step covers one frame
     }
     
     size_t Size() const { return hunger.size(); }
@@ -84,24 +174,43 @@ enum class ActionType : uint8_t {
     COUNT
 };
 
+// Kinetic-facing arrays are aligned and padded like TransformComponents
 struct alignas(CACHE_LINE_SIZE) ActionComponents {
-    std::vector<ActionType> current_action;
+    AlignedVector<ActionType> current_action;
     std::vector<float> action_utility;      // Score of current action
-    std::vector<EntityID> target_entity;    // Target for action (if any)
-    std::vector<float> target_x;            // Target position
-    std::vector<float> target_y;
-    std::vector<float> target_z;
+    AlignedVector<EntityID> target_entity;  // Target for action (if any)
+    AlignedVector<float> target_x;          // Target position
+    AlignedVector<float> target_y;
+    AlignedVector<float> target_z;
+    std::vector<uint32_t> last_decision_frame; // Frame the action was last re-evaluated
     
-    void Resize(size_t count) {
-        current_action.resize(count, ActionType::IDLE);
-        action_utility.resize(count);
-        target_entity.resize(count, INVALID_ENTITY);
-        target_x.resize(count);
-        target_y.resize(count);
-        target_z.resize(count);
+    size_t count = 0;
+    
+    void Resize(size_t new_count) {
+        count = new_count;
+        size_t padded = PaddedCount(new_count);
+        current_action.resize(padded, ActionType::IDLE);
+        action_utility.resize(new_count);
+        target_entity.resize(padded, INVALID_ENTITY);
+        target_x.resize(padded);
+        target_y.resize(padded);
+        target_z.resize(padded);
+        last_decision_frame.resize(new_count);
+    }
+    
+    // Entities [begin, end) from another buffer of the same size
+    void CopyRows(const ActionComponents& from, size_t begin, size_t end) {
+        std::copy(from.current_action.begin() + begin, from.current_action.begin() + end, current_action.begin() + begin);
+        std::copy(from.action_utility.begin() + begin, from.action_utility.begin() + end, action_utility.begin() + begin);
+        std::copy(from.target_entity.begin() + begin, from.target_entity.begin() + end, target_entity.begin() + begin);
+        std::copy(from.target_x.begin() + begin, from.target_x.begin() + end, target_x.begin() + begin);
+        std::copy(from.target_y.begin() + begin, from.target_y.begin() + end, target_y.begin() + begin);
+        std::copy(from.target_z.begin() + begin, from.target_z.begin() + end, target_z.begin() + begin);
+        std::copy(from.last_decision_frame.begin() + begin, from.last_decision_frame.begin() + end,
+                  last_decision_frame.begin() + begin);
     }
     
-    size_t Size() const { return current_action.size(); }
+    size_t Size() const { return count; }
 };
 
 // Cold Data - Rarely accessed (only when taking damage, etc.)
@@ -121,12 +230,113 @@ struct alignas(CACHE_LINE_SIZE) HealthComponents {
     size_t Size() const { return health.size(); }
 };
 
+// Level of Detail - How much simulation fidelity an entity gets
+struct alignas(CACHE_LINE_SIZE) LODComponents {
+    std::vector<uint8_t> tier;                // 0 = full detail, higher = coarser
+    std::vector<uint32_t> last_kinetic_frame; // Last frame whose motion was integrated
+    
+    void Resize(size_t count) {
+        tier.resize(count, 0);
+        last_kinetic_frame.resize(count, UINT32_MAX);
+    }
+    
+    size_t Size() const { return tier.size(); }
+};
+
+// Steering - Crowd forces computed each frame, consumed by the KineticSystem
+// Aligned and padded like TransformComponents for the SIMD kernel.
+struct alignas(CACHE_LINE_SIZE) SteeringComponents {
+    AlignedVector<float> separation_x; // Summed neighbour repulsion
+    AlignedVector<float> separation_y;
+    AlignedVector<float> guide_x;      // Unit direction from a flow field or path
+    AlignedVector<float> guide_y;      // (0, 0) = steer straight at the target
+    
+    size_t count = 0;
+    
+    void Resize(size_t new_count) {
+        count = new_count;
+        size_t padded = PaddedCount(new_count);
+        separation_x.resize(padded);
+        separation_y.resize(padded);
+        guide_x.resize(padded);
+        guide_y.resize(padded);
+    }
+    
+    size_t Size() const { return count; }
+};
+
+// Paths - Route each entity is following, filled in by the PathSystem
+enum class PathStatus : uint8_t {
+    NONE = 0, // Not navigating, or not yet asked
+    DIRECT,   // Target is in plain sight; steer straight at it
+    PENDING,  // Waiting in the pathfinding queue
+    READY,    // Following `waypoints`
+    FAILED    // Target unreachable; steer straight and let obstacles stop us
+};
+
+struct Waypoint {
+    float x, y;
+};
+
+struct PathComponents {
+    std::vector<PathStatus> status;
+    std::vector<int32_t> goal_cell;              // Grid cell the route leads to, -1 = none
+    std::vector<uint16_t> cursor;                // Next waypoint to steer toward
+    std::vector<std::vector<Waypoint>> waypoints;
+    
+    void Resize(size_t count) {
+        status.resize(count, PathStatus::NONE);
+        goal_cell.resize(count, -1);
+        cursor.resize(count, 0);
+        waypoints.resize(count);
+    }
+    
+    size_t Size() const { return status.size(); }
+};
+
+// ============================================================================
+// COMPONENT MASKS - What a system declares it reads and writes
+// ============================================================================
+using ComponentMask = uint32_t;
+
+namespace Component {
+    constexpr ComponentMask NONE         = 0;
+    constexpr ComponentMask TRANSFORMS   = 1u << 0;
+    constexpr ComponentMask PERCEPTION   = 1u << 1;
+    constexpr ComponentMask NEEDS        = 1u << 2;
+    constexpr ComponentMask ACTIONS      = 1u << 3;
+    constexpr ComponentMask HEALTH       = 1u << 4;
+    constexpr ComponentMask LOD          = 1u << 5;
+    constexpr ComponentMask SPATIAL_GRID = 1u << 6;
+    constexpr ComponentMask STIMULUS     = 1u << 7;
+    constexpr ComponentMask STEERING     = 1u << 8;
+    constexpr ComponentMask FLOW_FIELDS  = 1u << 9;
+    constexpr ComponentMask NAVIGATION   = 1u << 10; // Obstacles and the pathfinding service
+    constexpr ComponentMask PATHS        = 1u << 11;
+    constexpr ComponentMask INFLUENCE    = 1u << 12;
+    
+    // Back buffers of the components GameState can double-buffer
+    constexpr ComponentMask NEXT_TRANSFORMS = 1u << 13;
+    constexpr ComponentMask NEXT_ACTIONS    = 1u << 14;
+    constexpr ComponentMask DOUBLE_BUFFERABLE = TRANSFORMS | ACTIONS;
+    
+    // Where a system's writes land when `buffered` components are double-buffered
+    constexpr ComponentMask RedirectWrites(ComponentMask writes, ComponentMask buffered) {
+        const ComponentMask moved = writes & buffered;
+        return (writes & ~moved) |
+               ((moved & TRANSFORMS) ? NEXT_TRANSFORMS : NONE) |
+               ((moved & ACTIONS) ? NEXT_ACTIONS : NONE);
+    }
+}
+
 // ============================================================================
 // GAME STATE - The Single Source of Truth
 // ============================================================================
 
 struct GameState {
     size_t entity_count = 0;
+    uint32_t frame_index = 0; // Advanced once per simulated frame by the main loop
+    uint64_t random_seed = 0; // Keys every random draw (Determinism::Random)
     
     // Component Arrays
     TransformComponents transforms;
@@ -134,14 +344,56 @@ struct GameState {
     NeedsComponents needs;
     ActionComponents actions;
     HealthComponents health;
+    LODComponents lod;
+    SteeringComponents steering;
+    PathComponents paths;
+    
+    // Double buffering, optional per component (Component::DOUBLE_BUFFERABLE).
+    // Systems that write a buffered component fill next_* for frame N + 1
+    // while every reader still sees frame N; SwapBuffers() ends the frame by
+    // exchanging the two (vector swaps, so only pointers move).
+    ComponentMask double_buffered = Component::NONE;
+    TransformComponents next_transforms;
+    ActionComponents next_actions;
+    
+    void EnableDoubleBuffering(ComponentMask components) {
+        double_buffered = components & Component::DOUBLE_BUFFERABLE;
+        if (double_buffered & Component::TRANSFORMS) next_transforms = transforms;
+        if (double_buffered & Component::ACTIONS) next_actions = actions;
+    }
+    
+    // The buffer a writer of the component fills this frame
+    TransformComponents& WrittenTransforms() {
+        return (double_buffered & Component::TRANSFORMS) ? next_transforms : transforms;
+    }
+    
+    ActionComponents& WrittenActions() {
+        return (double_buffered & Component::ACTIONS) ? next_actions : actions;
+    }
+    
+    void SwapBuffers() {
+        if (double_buffered & Component::TRANSFORMS) std::swap(transforms, next_transforms);
+        if (double_buffered & Component::ACTIONS) std::swap(actions, next_actions);
+    }
     
     // Spatial Partition (for fast proximity queries)
     // Simple grid-based for now
     struct SpatialGrid {
         static constexpr int GRID_SIZE = 100;
         static constexpr float CELL_SIZE = 10.0f;
+        static constexpr int CELL_COUNT = GRID_SIZE * GRID_SIZE;
         std::vector<EntityID> cells[GRID_SIZE][GRID_SIZE];
         
+        // Flat index (x * GRID_SIZE + y) of the cell containing a world
+        // position, clamped to the grid
+        static int CellIndex(float x, float y) {
+            int cx = static_cast<int>(x / CELL_SIZE);
+            int cy = static_cast<int>(y / CELL_SIZE);
+            cx = cx < 0 ? 0 : (cx >= GRID_SIZE ? GRID_SIZE - 1 : cx);
+            cy = cy < 0 ? 0 : (cy >= GRID_SIZE ? GRID_SIZE - 1 : cy);
+            return cx * GRID_SIZE + cy;
+        }
+        
         void Clear() {
             for (int x = 0; x < GRID_SIZE; ++x) {
                 for (int y = 0; y < GRID_SIZE; ++y) {
@@ -163,10 +415,47 @@ struct GameState {
     
     // Stimulus Buffer - What each entity perceives
     struct StimulusBuffer {
-        std::vector<std::vector<EntityID>> visible_entities;
+        std::vector<std::vector<EntityID>> visible_entities; // Sorted ascending per observer
+        
+        // Visibility changes, optional: observers re-perceived this frame are
+        // diffed against their previous set. Each event is one (observer,
+        // target) pair; both arrays are rebuilt every frame.
+        struct VisibilityEvent {
+            EntityID observer;
+            EntityID target;
+        };
+        
+        bool build_visibility_events = false;
+        std::vector<std::vector<EntityID>> previous_visible;
+        std::vector<VisibilityEvent> entered;
+        std::vector<VisibilityEvent> exited;
+        
+        // Reverse index ("who sees me"), optional: the transposed relation in
+        // CSR form. The living observers of entity t are
+        // observers[observer_offsets[t] .. observer_offsets[t + 1]), ascending.
+        bool build_reverse_index = false;
+        std::vector<uint32_t> observer_offsets;
+        std::vector<EntityID> observers;
+        AtomicCounters observer_counts;        // Per target build scratch
+        std::vector<uint32_t> block_offsets;   // Per target block build scratch
+        
+        struct EntityRange {
+            const EntityID* first;
+            const EntityID* last;
+            const EntityID* begin() const { return first; }
+            const EntityID* end() const { return last; }
+            size_t size() const { return static_cast<size_t>(last - first); }
+        };
+        
+        EntityRange ObserversOf(EntityID target) const {
+            const EntityID* base = observers.data();
+            return {base + observer_offsets[target], base + observer_offsets[target + 1]};
+        }
         
         void Resize(size_t count) {
             visible_entities.resize(count);
+            previous_visible.resize(count);
+            observer_offsets.assign(count + 1, 0);
         }
         
         void Clear() {
@@ -178,6 +467,173 @@ struct GameState {
     
     StimulusBuffer stimulus_buffer;
     
+    // Influence Map - crowd density and threat per spatial grid cell, blurred
+    // so values fall off smoothly. Stored with a one-cell border of zeros
+    // (row stride GRID_SIZE + 2) so stencils and gradients need no edge cases.
+    struct InfluenceMap {
+        static constexpr int STRIDE = SpatialGrid::GRID_SIZE + 2;
+        static constexpr float DENSITY_WEIGHT = 0.5f; // Danger per (blurred) entity in a cell
+        static constexpr float THREAT_WEIGHT = 2.0f;  // Danger per (blurred) attacker in a cell
+        
+        std::vector<float> density;
+        std::vector<float> threat;
+        std::vector<float> danger;  // Weighted sum; above 1 is saturated
+        std::vector<float> scratch; // Blur temporary
+        
+        static int Index(int cx, int cy) { return (cx + 1) * STRIDE + (cy + 1); }
+        
+        static int IndexAt(float x, float y) {
+            int cell = SpatialGrid::CellIndex(x, y);
+            return Index(cell / SpatialGrid::GRID_SIZE, cell % SpatialGrid::GRID_SIZE);
+        }
+        
+        // Danger in [0, 1] at a world position
+        float SampleDanger(float x, float y) const {
+            float value = danger[IndexAt(x, y)];
+            return value < 1.0f ? value : 1.0f;
+        }
+        
+        // Downhill direction of the danger field (central differences); (0, 0)
+        // on flat ground
+        void FleeDirection(float x, float y, float& out_x, float& out_y) const {
+            int i = IndexAt(x, y);
+            float gradient_x = danger[i + STRIDE] - danger[i - STRIDE];
+            float gradient_y = danger[i + 1] - danger[i - 1];
+            float length_sq = gradient_x * gradient_x + gradient_y * gradient_y;
+            if (length_sq <= 1e-12f) {
+                out_x = 0.0f;
+                out_y = 0.0f;
+                return;
+            }
+            float inv_length = 1.0f / std::sqrt(length_sq);
+            out_x = -gradient_x * inv_length;
+            out_y = -gradient_y * inv_length;
+        }
+    };
+    
+    InfluenceMap influence;
+    
+    // Obstacles - static blocked cells at spatial grid resolution
+    struct ObstacleMap {
+        std::vector<uint8_t> blocked; // Per grid cell, indexed like SpatialGrid::CellIndex
+        size_t blocked_count = 0;
+        uint32_t version = 0;         // Bumped on every change; navigation data is keyed to it
+        
+        bool IsBlocked(int cx, int cy) const {
+            if (cx < 0 || cx >= SpatialGrid::GRID_SIZE || cy < 0 || cy >= SpatialGrid::GRID_SIZE) return true;
+            return blocked[cx * SpatialGrid::GRID_SIZE + cy] != 0;
+        }
+        
+        bool IsBlockedAt(float x, float y) const {
+            return blocked[SpatialGrid::CellIndex(x, y)] != 0;
+        }
+        
+        void SetBlocked(int cx, int cy, bool value) {
+            uint8_t& cell = blocked[cx * SpatialGrid::GRID_SIZE + cy];
+            if (cell == static_cast<uint8_t>(value)) return;
+            cell = static_cast<uint8_t>(value);
+            if (value) blocked_count++; else blocked_count--;
+            version++;
+        }
+    };
+    
+    ObstacleMap obstacles;
+    
+    // Flow Fields - shared steering toward popular goal cells, one field per
+    // goal at spatial grid resolution. A field stays valid until the obstacle
+    // map changes and is only rebuilt when next requested.
+    struct FlowFieldCache {
+        static constexpr size_t MAX_FIELDS = 16;
+        static constexpr int CELL_COUNT = SpatialGrid::CELL_COUNT;
+        static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+        static constexpr uint8_t NO_DIRECTION = 8;
+        
+        struct Field {
+            int goal_cell = -1;
+            uint32_t version = 0;              // Obstacle map version it was built against
+            uint32_t last_used_frame = 0;
+            std::vector<uint32_t> integration; // Path cost to the goal per cell
+            std::vector<uint8_t> direction;    // Neighbour (0-7) to step toward per cell
+        };
+        
+        std::vector<Field> fields;
+        std::vector<int16_t> slot_of_goal;     // Field slot per goal cell this frame, -1 = none
+        std::vector<uint16_t> demand;          // Agents heading to each cell this frame
+        uint64_t builds = 0;
+        uint64_t reuses = 0;
+    };
+    
+    FlowFieldCache flow_fields;
+    
+    // Pathfinding - requests queued by the PathSystem and served within a
+    // per-frame time budget (or a fixed batch count, which unlike a clock
+    // gives the same paths on every run). Searches run on a graph of cluster entrances
+    // (hierarchical A*); routes between clusters are cached by
+    // (start cluster, goal cluster) until the obstacle map changes.
+    struct PathfindingService {
+        static constexpr int CLUSTER_SIZE = 10; // Grid cells per cluster side
+        static constexpr int CLUSTERS_PER_SIDE = SpatialGrid::GRID_SIZE / CLUSTER_SIZE;
+        static constexpr int CLUSTER_COUNT = CLUSTERS_PER_SIDE * CLUSTERS_PER_SIDE;
+        
+        struct Request {
+            EntityID entity;
+            int32_t start_cell;
+            int32_t goal_cell;
+        };
+        
+        struct Edge {
+            uint32_t to;
+            uint32_t cost;
+        };
+        
+        // Abstract graph: one node per cell on either side of a cluster entrance
+        struct Graph {
+            uint32_t version = UINT32_MAX;               // Obstacle map version it reflects
+            std::vector<int32_t> node_cell;
+            std::vector<std::vector<Edge>> edges;
+            std::vector<std::vector<uint32_t>> cluster_nodes;
+        };
+        
+        Graph graph;
+        std::vector<Request> queue;                      // FIFO; served from queue_head
+        size_t queue_head = 0;
+        std::unordered_map<uint32_t, std::vector<int32_t>> route_cache; // Cell route, empty = unreachable
+        float frame_budget_ms = 1.0f;
+        uint32_t frame_batch_limit = 0;  // Batches per frame instead of the time budget, 0 = off
+        uint64_t completed = 0;
+        uint64_t cache_hits = 0;
+        uint64_t cache_misses = 0;
+        
+        size_t Backlog() const { return queue.size() - queue_head; }
+    };
+    
+    PathfindingService pathfinding;
+    
+    // Scheduling - how many frames a time-sliced system takes to visit everyone
+    struct SchedulingConfig {
+        uint32_t perception_slices = 1; // 1 = every entity, every frame
+        uint32_t utility_slices = 1;
+    };
+    
+    SchedulingConfig scheduling;
+    
+    // Level of Detail - entities far from every region of interest tick less often
+    struct RegionOfInterest {
+        float x, y;
+        float radius;
+    };
+    
+    struct LODConfig {
+        static constexpr int TIER_COUNT = 3;
+        // Max distance outside the nearest region for tiers 0..TIER_COUNT-2
+        float tier_distance[TIER_COUNT - 1] = {0.0f, 200.0f};
+        uint32_t tier_period[TIER_COUNT] = {1, 4, 16}; // Frames between updates
+        float hysteresis = 10.0f; // Extra distance needed before demoting
+    };
+    
+    std::vector<RegionOfInterest> regions_of_interest; // Empty = everything at tier 0
+    LODConfig lod_config;
+    
     // Initialize with N entities
     void Initialize(size_t count) {
         entity_count = count;
@@ -186,20 +642,67 @@ struct GameState {
         needs.Resize(count);
         actions.Resize(count);
         health.Resize(count);
+        lod.Resize(count);
+        steering.Resize(count);
+        paths.Resize(count);
         stimulus_buffer.Resize(count);
+        obstacles.blocked.assign(SpatialGrid::CELL_COUNT, 0);
+        obstacles.blocked_count = 0;
+        const size_t influence_cells = static_cast<size_t>(InfluenceMap::STRIDE) * InfluenceMap::STRIDE;
+        influence.density.assign(influence_cells, 0.0f);
+        influence.threat.assign(influence_cells, 0.0f);
+        influence.danger.assign(influence_cells, 0.0f);
+        influence.scratch.assign(influence_cells, 0.0f);
+    }
+    
+    // Grow or shrink every per-entity component; new rows take defaults
+    void Resize(size_t count) {
+        entity_count = count;
+        transforms.Resize(count);
+        perception.Resize(count);
+        needs.Resize(count);
+        actions.Resize(count);
+        health.Resize(count);
+        lod.Resize(count);
+        steering.Resize(count);
+        paths.Resize(count);
+        stimulus_buffer.Resize(count);
+        if (double_buffered & Component::TRANSFORMS) next_transforms.Resize(count);
+        if (double_buffered & Component::ACTIONS) next_actions.Resize(count);
+    }
+    
+    // Overwrite entity `to` with entity `from` (compaction). Visible sets
+    // hold entity indices, which do not survive the move; they are cleared
+    // and rebuilt by the next perception pass.
+    void CopyEntity(EntityID from, EntityID to) {
+        auto copy = [from, to](auto& column) { column[to] = column[from]; };
+        copy(transforms.position_x); copy(transforms.position_y); copy(transforms.position_z);
+        copy(transforms.velocity_x); copy(transforms.velocity_y); copy(transforms.velocity_z);
+        copy(transforms.heading_x); copy(transforms.heading_y);
+        copy(perception.view_range); copy(perception.view_angle);
+        copy(perception.visible_entity_count); copy(perception.last_perception_frame);
+        copy(needs.hunger); copy(needs.energy); copy(needs.safety); copy(needs.curiosity);
+        copy(needs.danger_level); copy(needs.last_update_frame);
+        copy(actions.current_action); copy(actions.action_utility); copy(actions.target_entity);
+        copy(actions.target_x); copy(actions.target_y); copy(actions.target_z);
+        copy(actions.last_decision_frame);
+        copy(health.health); copy(health.max_health); copy(health.armor_type); copy(health.is_alive);
+        copy(lod.tier); copy(lod.last_kinetic_frame);
+        copy(steering.separation_x); copy(steering.separation_y);
+        copy(steering.guide_x); copy(steering.guide_y);
+        copy(paths.status); copy(paths.goal_cell); copy(paths.cursor); copy(paths.waypoints);
+        stimulus_buffer.visible_entities[to].clear();
+        stimulus_buffer.previous_visible[to].clear();
     }
     
     // Add a new entity
     EntityID AddEntity() {
         EntityID id = static_cast<EntityID>(entity_count);
-        entity_count++;
-        
-        transforms.Resize(entity_count);
-        perception.Resize(entity_count);
-        needs.Resize(entity_count);
-        actions.Resize(entity_count);
-        health.Resize(entity_count);
-        stimulus_buffer.Resize(entity_count);
+        Resize(entity_count + 1);
+        
+        // Incremental systems start counting from the frame the entity joined
+        needs.last_update_frame[id] = frame_index - 1;
+        lod.last_kinetic_frame[id] = frame_index - 1;
         
         return id;
     }
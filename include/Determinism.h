@@ -0,0 +1,193 @@
+#pragma once
+
+#include "Components.h"
+#include "Parallel.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// ============================================================================
+// DETERMINISM - "The Metronome"
+// The same seed and inputs must give bit-identical frames for any thread
+// count. Work is split into chunks whose boundaries depend only on the data
+// size, reductions fold their partials in chunk order, and random numbers
+// are a pure function of (seed, stream, entity, counter) rather than a
+// shared generator whose sequence depends on who calls it first. A per-frame
+// checksum of the state makes any divergence visible at the frame it starts.
+// ============================================================================
+
+namespace Determinism {
+
+// ============================================================================
+// HASHING - xxHash64 (reference algorithm, little-endian loads)
+// ============================================================================
+
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t RotateLeft(uint64_t x, int bits) {
+    return (x << bits) | (x >> (64 - bits));
+}
+
+inline uint64_t Load64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t Load32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    return RotateLeft(acc, 31) * PRIME64_1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t value) {
+    acc ^= Round(0, value);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+inline uint64_t Hash64(const void* data, size_t length, uint64_t seed = 0) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint8_t* const end = p + length;
+    uint64_t h;
+    
+    if (length >= 32) {
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+        for (; p + 32 <= end; p += 32) {
+            v1 = Round(v1, Load64(p));
+            v2 = Round(v2, Load64(p + 8));
+            v3 = Round(v3, Load64(p + 16));
+            v4 = Round(v4, Load64(p + 24));
+        }
+        h = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        h = MergeRound(h, v1);
+        h = MergeRound(h, v2);
+        h = MergeRound(h, v3);
+        h = MergeRound(h, v4);
+    } else {
+        h = seed + PRIME64_5;
+    }
+    h += static_cast<uint64_t>(length);
+    
+    for (; p + 8 <= end; p += 8) {
+        h ^= Round(0, Load64(p));
+        h = RotateLeft(h, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(Load32(p)) * PRIME64_1;
+        h = RotateLeft(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= (*p) * PRIME64_5;
+        h = RotateLeft(h, 11) * PRIME64_1;
+    }
+    
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+// ============================================================================
+// COUNTER-BASED RANDOM NUMBERS
+// Each draw hashes its own coordinates, so it does not matter which thread
+// makes it or in what order. Counters are frame numbers: an entity draws at
+// most once per stream per frame.
+// ============================================================================
+
+enum Stream : uint32_t {
+    CURIOSITY = 1, // NeedsModel curiosity drift
+    EXPLORE_X,     // UtilitySystem exploration target
+    EXPLORE_Y
+};
+
+// splitmix64 finalizer: a bijection with full avalanche
+inline uint64_t Mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+inline uint64_t Random(uint64_t seed, Stream stream, EntityID entity, uint64_t counter) {
+    const uint64_t key = Mix64(seed ^ ((static_cast<uint64_t>(stream) << 32 | entity) * PRIME64_2));
+    return Mix64(key + counter * PRIME64_1);
+}
+
+// Uniform in [0, bound), by multiply-shift (no modulo bias worth measuring)
+inline uint32_t RandomBelow(uint64_t seed, Stream stream, EntityID entity, uint64_t counter, uint32_t bound) {
+    return static_cast<uint32_t>(((Random(seed, stream, entity, counter) >> 32) * bound) >> 32);
+}
+
+// ============================================================================
+// STATE CHECKSUM - One 64-bit fingerprint per frame
+// Covers the per-entity components a FrameSnapshot captures. Entities are
+// hashed in fixed CHECKSUM_CHUNK-sized chunks, in parallel, and the chunk
+// hashes are folded in order, so the value is the same for any thread count.
+// ============================================================================
+
+constexpr size_t CHECKSUM_CHUNK = 256;
+constexpr ComponentMask CHECKSUM_READS = Component::TRANSFORMS | Component::PERCEPTION | Component::NEEDS |
+    Component::ACTIONS | Component::HEALTH | Component::LOD | Component::PATHS;
+
+inline uint64_t HashChunk(const GameState& state, size_t begin, size_t end) {
+    uint64_t h = begin;
+    auto add = [&h, begin, end](const auto& column) {
+        h = Hash64(column.data() + begin, (end - begin) * sizeof(column[0]), h);
+    };
+    
+    const TransformComponents& t = state.transforms;
+    add(t.position_x); add(t.position_y); add(t.position_z);
+    add(t.velocity_x); add(t.velocity_y); add(t.velocity_z);
+    add(t.heading_x); add(t.heading_y);
+    
+    const PerceptionComponents& p = state.perception;
+    add(p.view_range); add(p.view_angle); add(p.visible_entity_count); add(p.last_perception_frame);
+    
+    const NeedsComponents& n = state.needs;
+    add(n.hunger); add(n.energy); add(n.safety); add(n.curiosity);
+    add(n.danger_level); add(n.last_update_frame);
+    
+    const ActionComponents& a = state.actions;
+    add(a.current_action); add(a.action_utility); add(a.target_entity);
+    add(a.target_x); add(a.target_y); add(a.target_z); add(a.last_decision_frame);
+    
+    const HealthComponents& health = state.health;
+    add(health.health); add(health.max_health); add(health.armor_type);
+    thread_local std::vector<uint8_t> alive; // vector<bool> has no data()
+    alive.assign(end - begin, 0);
+    for (size_t i = begin; i < end; ++i) alive[i - begin] = health.is_alive[i];
+    h = Hash64(alive.data(), alive.size(), h);
+    
+    add(state.lod.tier); add(state.lod.last_kinetic_frame);
+    add(state.paths.status);
+    return h;
+}
+
+inline uint64_t StateChecksum(const GameState& state) {
+    const uint64_t header[2] = {state.entity_count, state.frame_index};
+    return Parallel::ReduceOrdered(0, state.entity_count, CHECKSUM_CHUNK, Hash64(header, sizeof(header)),
+        [&state](size_t begin, size_t end) { return HashChunk(state, begin, end); },
+        [](uint64_t folded, uint64_t chunk) {
+            const uint64_t pair[2] = {folded, chunk};
+            return Hash64(pair, sizeof(pair));
+        });
+}
+
+} // namespace Determinism
@@ -5,6 +5,15 @@
 #include <fstream>
 #include <chrono>
 #include <random>
+#include <string>
+#include <sstream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 // ============================================================================
 // PROACTIVE VERIFICATION - "The Immune System"
@@ -21,6 +30,19 @@ private:
     uint64_t frame_number = 0;
     
 public:
+    struct Event {
+        std::string name;
+        EntityID entity;
+    };
+    
+private:
+    std::vector<Event> deferred_events;
+    bool defer_events = false;
+    
+public:
+    static constexpr ComponentMask READS = Component::TRANSFORMS | Component::ACTIONS | Component::NEEDS;
+    static constexpr ComponentMask VISIBILITY_READS = Component::STIMULUS; // LogVisibilityChanges
+    
     StateLogger(const std::string& filename) {
         log_file.open(filename, std::ios::binary);
     }
@@ -35,22 +57,119 @@ public:
         if (!log_file.is_open()) return;
         
         // Write frame header
+        uint8_t marker = 0xFC;
+        log_file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
         log_file.write(reinterpret_cast<const char*>(&frame_number), sizeof(frame_number));
         log_file.write(reinterpret_cast<const char*>(&state.entity_count), sizeof(state.entity_count));
         
-        // Log critical state (positions, actions, needs)
+        // Log critical state (positions, actions, needs). Needs are settled
+        // lazily, so each row carries the frame its hunger/energy are as of.
         for (EntityID i = 0; i < state.entity_count; ++i) {
             log_file.write(reinterpret_cast<const char*>(&state.transforms.position_x[i]), sizeof(float));
             log_file.write(reinterpret_cast<const char*>(&state.transforms.position_y[i]), sizeof(float));
             log_file.write(reinterpret_cast<const char*>(&state.actions.current_action[i]), sizeof(ActionType));
             log_file.write(reinterpret_cast<const char*>(&state.needs.hunger[i]), sizeof(float));
             log_file.write(reinterpret_cast<const char*>(&state.needs.energy[i]), sizeof(float));
+            log_file.write(reinterpret_cast<const char*>(&state.needs.last_update_frame[i]), sizeof(uint32_t));
         }
         
         frame_number++;
     }
     
+    // Visibility changes recorded this frame, as two raw arrays of
+    // (observer, target) pairs; far smaller than logging every visible set
+    void LogVisibilityChanges(const GameState& state) {
+        if (!log_file.is_open()) return;
+        
+        using Event = GameState::StimulusBuffer::VisibilityEvent;
+        const std::vector<Event>& entered = state.stimulus_buffer.entered;
+        const std::vector<Event>& exited = state.stimulus_buffer.exited;
+        uint32_t entered_count = static_cast<uint32_t>(entered.size());
+        uint32_t exited_count = static_cast<uint32_t>(exited.size());
+        
+        uint8_t marker = 0xFE;
+        log_file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+        log_file.write(reinterpret_cast<const char*>(&frame_number), sizeof(frame_number));
+        log_file.write(reinterpret_cast<const char*>(&entered_count), sizeof(entered_count));
+        log_file.write(reinterpret_cast<const char*>(&exited_count), sizeof(exited_count));
+        log_file.write(reinterpret_cast<const char*>(entered.data()), entered_count * sizeof(Event));
+        log_file.write(reinterpret_cast<const char*>(exited.data()), exited_count * sizeof(Event));
+    }
+    
+    // Determinism::StateChecksum of the frame about to be logged
+    void LogChecksum(uint64_t checksum) {
+        if (!log_file.is_open()) return;
+        
+        uint8_t marker = 0xFD;
+        log_file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+        log_file.write(reinterpret_cast<const char*>(&frame_number), sizeof(frame_number));
+        log_file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+    }
+    
+    // Checksums recorded in an earlier log, indexed by frame (empty if the
+    // file is missing or carries none). Walks every record type:
+    //   0xFC frame       [frame u64][count size_t][count x 21-byte entity rows]
+    //   0xFD checksum    [frame u64][checksum u64]
+    //   0xFE visibility  [frame u64][entered u32][exited u32][pairs]
+    //   0xFF event       [frame u64][entity u32][length size_t][name]
+    static std::vector<uint64_t> ReadChecksums(const std::string& filename) {
+        std::vector<uint64_t> checksums;
+        std::ifstream in(filename, std::ios::binary);
+        constexpr size_t ROW_BYTES = 4 * sizeof(float) + sizeof(ActionType) + sizeof(uint32_t);
+        
+        auto read = [&in](auto& value) {
+            in.read(reinterpret_cast<char*>(&value), sizeof(value));
+            return static_cast<bool>(in);
+        };
+        
+        uint8_t marker;
+        uint64_t frame;
+        while (read(marker) && read(frame)) {
+            if (marker == 0xFC) {
+                size_t count;
+                if (!read(count)) break;
+                in.seekg(static_cast<std::streamoff>(count * ROW_BYTES), std::ios::cur);
+            } else if (marker == 0xFD) {
+                uint64_t checksum;
+                if (!read(checksum)) break;
+                if (checksums.size() <= frame) checksums.resize(frame + 1, 0);
+                checksums[frame] = checksum;
+            } else if (marker == 0xFE) {
+                uint32_t entered, exited;
+                if (!read(entered) || !read(exited)) break;
+                const size_t pairs = static_cast<size_t>(entered) + exited;
+                in.seekg(static_cast<std::streamoff>(pairs * sizeof(GameState::StimulusBuffer::VisibilityEvent)),
+                         std::ios::cur);
+            } else if (marker == 0xFF) {
+                EntityID entity;
+                size_t name_len;
+                if (!read(entity) || !read(name_len)) break;
+                in.seekg(static_cast<std::streamoff>(name_len), std::ios::cur);
+            } else {
+                break; // Not a log this version wrote
+            }
+        }
+        return checksums;
+    }
+    
     void LogEvent(const std::string& event_name, EntityID entity_id) {
+        if (defer_events) {
+            deferred_events.push_back({event_name, entity_id});
+            return;
+        }
+        WriteEvent(event_name, entity_id);
+    }
+    
+    // With frames written on a background stage, events raised on the
+    // simulation thread wait here and travel with their frame's snapshot
+    void SetDeferEvents(bool defer) { defer_events = defer; }
+    
+    void TakeDeferredEvents(std::vector<Event>& out) {
+        out.clear();
+        out.swap(deferred_events);
+    }
+    
+    void WriteEvent(const std::string& event_name, EntityID entity_id) {
         if (!log_file.is_open()) return;
         
         // Log event marker
@@ -125,6 +244,11 @@ private:
     
     std::vector<ProfileEntry> entries;
     ProfileEntry* current_entry = nullptr;
+    std::mutex entries_mutex; // Scheduled systems may finish concurrently
+    
+    // Values reported after the timings but not summed into them (e.g. the
+    // tick driver's pacing); kept across Clear() until overwritten
+    std::vector<std::pair<std::string, double>> stats;
     
 public:
     void BeginProfile(const std::string& name) {
@@ -142,24 +266,199 @@ public:
         }
     }
     
-    void PrintReport() {
-        std::cout << "\n=== PERFORMANCE REPORT ===" << std::endl;
+    // A finished measurement; safe to call from several threads at once
+    void Record(const std::string& name, std::chrono::high_resolution_clock::time_point start,
+                std::chrono::high_resolution_clock::time_point end) {
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::lock_guard<std::mutex> lock(entries_mutex);
+        entries.push_back({name, start, end, duration.count() / 1000.0});
+    }
+    
+    void PrintReport(std::ostream& out = std::cout) {
+        out << "\n=== PERFORMANCE REPORT ===" << std::endl;
         double total_time = 0.0;
         
         for (const auto& entry : entries) {
-            std::cout << entry.name << ": " << entry.duration_ms << " ms" << std::endl;
+            out << entry.name << ": " << entry.duration_ms << " ms" << std::endl;
             total_time += entry.duration_ms;
         }
         
-        std::cout << "TOTAL: " << total_time << " ms" << std::endl;
-        std::cout << "FPS: " << (1000.0 / total_time) << std::endl;
-        std::cout << "=========================\n" << std::endl;
+        out << "TOTAL: " << total_time << " ms" << std::endl;
+        out << "FPS: " << (1000.0 / total_time) << std::endl;
+        for (const auto& stat : stats) {
+            out << stat.first << ": " << stat.second << std::endl;
+        }
+        out << "=========================\n" << std::endl;
+    }
+    
+    void SetStat(const std::string& name, double value) {
+        for (auto& stat : stats) {
+            if (stat.first == name) {
+                stat.second = value;
+                return;
+            }
+        }
+        stats.emplace_back(name, value);
     }
     
     void Clear() {
         entries.clear();
         current_entry = nullptr;
     }
+    
+    // Time recorded under `name` this frame (0 if it was not profiled)
+    double GetDuration(const std::string& name) const {
+        double total = 0.0;
+        for (const auto& entry : entries) {
+            if (entry.name == name) total += entry.duration_ms;
+        }
+        return total;
+    }
+    
+    double GetTotal() const {
+        double total = 0.0;
+        for (const auto& entry : entries) {
+            total += entry.duration_ms;
+        }
+        return total;
+    }
+};
+
+// ============================================================================
+// FRAME BUDGET CONTROLLER - Trade fidelity for frame time automatically
+// Watches the frame's wall time (the scheduler's critical path, not the sum
+// of overlapping stages) and walks a ladder of knobs: perception slicing,
+// utility slicing, then tighter LOD bands. It steps down the ladder while
+// over budget and back up once there is comfortable headroom, never past the
+// configured starting point. Profiled system costs only pick which knob to
+// turn.
+// ============================================================================
+class FrameBudgetController {
+private:
+    double budget_ms;
+    StateLogger* logger;
+    
+    double smoothed_ms = 0.0;      // EMA of the frame's wall time
+    uint32_t cooldown = 0;         // Frames left before the next adjustment
+    bool has_baseline = false;
+    float baseline_tier_distance[GameState::LODConfig::TIER_COUNT - 1] = {};
+    uint32_t baseline_perception_slices = 1;
+    uint32_t baseline_utility_slices = 1;
+    
+public:
+    static constexpr double SMOOTHING = 0.2;     // EMA weight of the newest frame
+    static constexpr double RELAX_RATIO = 0.6;   // Restore fidelity below this share of budget
+    static constexpr uint32_t COOLDOWN_FRAMES = 10;
+    static constexpr uint32_t MAX_SLICES = 8;
+    static constexpr float LOD_SHRINK = 0.75f;   // Band scale per LOD step
+    static constexpr float MIN_LOD_SCALE = 0.25f;
+    
+    FrameBudgetController(double budget, StateLogger* log = nullptr)
+        : budget_ms(budget), logger(log) {}
+    
+    double GetSmoothedCost() const { return smoothed_ms; }
+    
+    // frame_ms: measured wall time of SystemScheduler::Run for this frame
+    void Update(const Profiler& profiler, GameState& state, double frame_ms) {
+        smoothed_ms = smoothed_ms == 0.0 ? frame_ms : smoothed_ms + SMOOTHING * (frame_ms - smoothed_ms);
+        
+        if (!has_baseline) {
+            for (int t = 0; t < GameState::LODConfig::TIER_COUNT - 1; ++t) {
+                baseline_tier_distance[t] = state.lod_config.tier_distance[t];
+            }
+            baseline_perception_slices = state.scheduling.perception_slices;
+            baseline_utility_slices = state.scheduling.utility_slices;
+            has_baseline = true;
+        }
+        
+        if (cooldown > 0) {
+            cooldown--;
+            return;
+        }
+        
+        if (smoothed_ms > budget_ms) {
+            Degrade(profiler, state);
+        } else if (smoothed_ms < budget_ms * RELAX_RATIO) {
+            Restore(state);
+        }
+    }
+    
+private:
+    float LODScale(const GameState& state) const {
+        // Band 0 can legitimately be 0, so measure against the outermost band
+        const int last = GameState::LODConfig::TIER_COUNT - 2;
+        if (baseline_tier_distance[last] <= 0.0f) return 1.0f;
+        return state.lod_config.tier_distance[last] / baseline_tier_distance[last];
+    }
+    
+    void ScaleLOD(GameState& state, float scale) {
+        for (int t = 0; t < GameState::LODConfig::TIER_COUNT - 1; ++t) {
+            state.lod_config.tier_distance[t] = baseline_tier_distance[t] * scale;
+        }
+    }
+    
+    void Degrade(const Profiler& profiler, GameState& state) {
+        GameState::SchedulingConfig& sched = state.scheduling;
+        const double perception_ms = profiler.GetDuration("PerceptionSystem");
+        const double utility_ms = profiler.GetDuration("UtilitySystem") +
+                                  profiler.GetDuration("NeedsUtilitySystem"); // Fused pass
+        
+        // Slice whichever of the two sliceable systems currently costs more
+        bool perception_first = perception_ms >= utility_ms;
+        if (perception_first && sched.perception_slices < MAX_SLICES) {
+            sched.perception_slices++;
+            Log(state, "perception_slices", sched.perception_slices);
+        } else if (sched.utility_slices < MAX_SLICES) {
+            sched.utility_slices++;
+            Log(state, "utility_slices", sched.utility_slices);
+        } else if (sched.perception_slices < MAX_SLICES) {
+            sched.perception_slices++;
+            Log(state, "perception_slices", sched.perception_slices);
+        } else if (LODScale(state) > MIN_LOD_SCALE) {
+            float scale = std::max(MIN_LOD_SCALE, LODScale(state) * LOD_SHRINK);
+            ScaleLOD(state, scale);
+            Log(state, "lod_scale", scale);
+        } else {
+            return; // Every knob is at its floor
+        }
+        cooldown = COOLDOWN_FRAMES;
+    }
+    
+    void Restore(GameState& state) {
+        // Undo in the reverse order of Degrade: LOD bands first, then slicing,
+        // stopping at the slice counts the run was configured with
+        GameState::SchedulingConfig& sched = state.scheduling;
+        const uint32_t extra_utility = sched.utility_slices > baseline_utility_slices ?
+            sched.utility_slices - baseline_utility_slices : 0;
+        const uint32_t extra_perception = sched.perception_slices > baseline_perception_slices ?
+            sched.perception_slices - baseline_perception_slices : 0;
+        if (LODScale(state) < 1.0f) {
+            float scale = std::min(1.0f, LODScale(state) / LOD_SHRINK);
+            ScaleLOD(state, scale);
+            Log(state, "lod_scale", scale);
+        } else if (extra_utility > 0 && extra_utility >= extra_perception) {
+            sched.utility_slices--;
+            Log(state, "utility_slices", sched.utility_slices);
+        } else if (extra_perception > 0) {
+            sched.perception_slices--;
+            Log(state, "perception_slices", sched.perception_slices);
+        } else {
+            return; // Already at the configured fidelity
+        }
+        cooldown = COOLDOWN_FRAMES;
+    }
+    
+    void Log(const GameState& state, const std::string& knob, double value) {
+        // A single write, so it never interleaves with the diagnostics thread
+        std::ostringstream line;
+        line << "[BUDGET] Frame " << state.frame_index
+             << ": cost " << smoothed_ms << " ms vs budget " << budget_ms
+             << " ms -> " << knob << " = " << value << "\n";
+        std::cout << line.str() << std::flush;
+        if (logger) {
+            logger->LogEvent("budget:" + knob + "=" + std::to_string(value), INVALID_ENTITY);
+        }
+    }
 };
 
 // ============================================================================
@@ -168,14 +467,15 @@ public:
 class ProfileScope {
 private:
     Profiler& profiler;
+    std::string name;
+    std::chrono::high_resolution_clock::time_point start;
     
 public:
-    ProfileScope(Profiler& p, const std::string& name) : profiler(p) {
-        profiler.BeginProfile(name);
-    }
+    ProfileScope(Profiler& p, const std::string& scope_name)
+        : profiler(p), name(scope_name), start(std::chrono::high_resolution_clock::now()) {}
     
     ~ProfileScope() {
-        profiler.EndProfile();
+        profiler.Record(name, start, std::chrono::high_resolution_clock::now());
     }
 };
 
@@ -222,6 +522,23 @@ public:
                 std::cerr << "[VALIDATION ERROR] Invalid hunger for entity " << i << std::endl;
                 valid = false;
             }
+            
+            // Visible sets and action targets are row indices; a stale one
+            // names another entity or none at all
+            if (i < state.stimulus_buffer.visible_entities.size()) {
+                for (EntityID target : state.stimulus_buffer.visible_entities[i]) {
+                    if (target >= state.entity_count) {
+                        std::cerr << "[VALIDATION ERROR] Entity " << i << " sees missing entity " << target << std::endl;
+                        valid = false;
+                    }
+                }
+            }
+            
+            const EntityID target = state.actions.target_entity[i];
+            if (target != INVALID_ENTITY && target >= state.entity_count) {
+                std::cerr << "[VALIDATION ERROR] Entity " << i << " targets missing entity " << target << std::endl;
+                valid = false;
+            }
         }
         
         return valid;
@@ -240,12 +557,20 @@ public:
         std::cout << "Velocity: (" 
                   << state.transforms.velocity_x[entity_id] << ", "
                   << state.transforms.velocity_y[entity_id] << ")" << std::endl;
-        std::cout << "Orientation: " << state.transforms.orientation[entity_id] << std::endl;
+        std::cout << "Heading: (" 
+                  << state.transforms.heading_x[entity_id] << ", "
+                  << state.transforms.heading_y[entity_id] << ")" << std::endl;
+        std::cout << "Orientation: " 
+                  << std::atan2(state.transforms.heading_y[entity_id], state.transforms.heading_x[entity_id])
+                  << " rad" << std::endl;
         std::cout << "Action: " << static_cast<int>(state.actions.current_action[entity_id]) << std::endl;
         std::cout << "Hunger: " << state.needs.hunger[entity_id] << std::endl;
         std::cout << "Energy: " << state.needs.energy[entity_id] << std::endl;
         std::cout << "Safety: " << state.needs.safety[entity_id] << std::endl;
         std::cout << "Visible Entities: " << state.perception.visible_entity_count[entity_id] << std::endl;
+        if (state.stimulus_buffer.build_reverse_index) {
+            std::cout << "Seen By: " << state.stimulus_buffer.ObserversOf(entity_id).size() << std::endl;
+        }
         std::cout << "Health: " << state.health.health[entity_id] << "/" 
                   << state.health.max_health[entity_id] << std::endl;
         std::cout << "Alive: " << (state.health.is_alive[entity_id] ? "Yes" : "No") << std::endl;
@@ -253,4 +578,132 @@ public:
     }
 };
 
+// ============================================================================
+// DIAGNOSTICS PIPELINE - "The Night Shift"
+// Each finished frame is copied into a read-only snapshot, and logging,
+// validation and stats run on a background thread while the next frame
+// simulates. Snapshots come from a ring of `depth` reusable buffers (2 =
+// double-buffered); when all of them are still in flight, Acquire() blocks
+// the simulation until the background stage catches up (back-pressure).
+// ============================================================================
+
+// The parts of a frame the diagnostics read. `state` is a partial copy:
+// only the components listed in Capture() are filled in.
+struct FrameSnapshot {
+    GameState state;
+    int frame = 0;
+    bool with_stats = false;                // Stats and profile report due
+    std::string profile_report;
+    std::vector<StateLogger::Event> events; // Logged during this frame
+    
+    void Capture(const GameState& live, int frame_number, bool stats) {
+        frame = frame_number;
+        with_stats = stats;
+        
+        state.entity_count = live.entity_count;
+        state.frame_index = live.frame_index;
+        state.transforms = live.transforms;
+        state.perception = live.perception;
+        state.needs = live.needs;
+        state.actions = live.actions;
+        state.health = live.health;
+        state.lod = live.lod;
+        state.paths.status = live.paths.status;
+        state.stimulus_buffer.build_visibility_events = live.stimulus_buffer.build_visibility_events;
+        state.stimulus_buffer.entered = live.stimulus_buffer.entered;
+        state.stimulus_buffer.exited = live.stimulus_buffer.exited;
+        
+        if (stats) {
+            state.flow_fields = live.flow_fields;
+            state.pathfinding.queue.assign(live.pathfinding.queue.begin() + live.pathfinding.queue_head,
+                                           live.pathfinding.queue.end());
+            state.pathfinding.queue_head = 0;
+            state.pathfinding.completed = live.pathfinding.completed;
+            state.pathfinding.cache_hits = live.pathfinding.cache_hits;
+            state.pathfinding.cache_misses = live.pathfinding.cache_misses;
+        }
+    }
+};
+
+class DiagnosticsPipeline {
+public:
+    using Stage = std::function<void(const FrameSnapshot&)>;
+    
+    DiagnosticsPipeline(size_t depth, Stage stage_fn)
+        : snapshots(std::max<size_t>(1, depth)), stage(std::move(stage_fn)),
+          worker([this]() { WorkerLoop(); }) {}
+    
+    ~DiagnosticsPipeline() {
+        Drain();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_ready.notify_one();
+        worker.join();
+    }
+    
+    DiagnosticsPipeline(const DiagnosticsPipeline&) = delete;
+    DiagnosticsPipeline& operator=(const DiagnosticsPipeline&) = delete;
+    
+    // The next free buffer; waits while every buffer is still queued
+    FrameSnapshot& Acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (submitted - completed >= snapshots.size()) {
+            auto start = std::chrono::high_resolution_clock::now();
+            slot_free.wait(lock, [this]() { return submitted - completed < snapshots.size(); });
+            stall_ms += std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - start).count();
+            stalls++;
+        }
+        return snapshots[submitted % snapshots.size()];
+    }
+    
+    // Hand the buffer returned by Acquire() to the background stage
+    void Submit() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            submitted++;
+        }
+        work_ready.notify_one();
+    }
+    
+    // Wait until every submitted snapshot has been processed
+    void Drain() {
+        std::unique_lock<std::mutex> lock(mutex);
+        slot_free.wait(lock, [this]() { return completed == submitted; });
+    }
+    
+    size_t Depth() const { return snapshots.size(); }
+    uint64_t Stalls() const { return stalls; }
+    double StallMs() const { return stall_ms; }
+    
+private:
+    std::vector<FrameSnapshot> snapshots;
+    Stage stage;
+    uint64_t submitted = 0;  // Snapshots handed over so far
+    uint64_t completed = 0;  // Snapshots the stage has finished with
+    uint64_t stalls = 0;     // Acquire() calls that had to wait
+    double stall_ms = 0.0;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable slot_free;
+    std::thread worker;      // Declared last: starts once the rest exists
+    
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            work_ready.wait(lock, [this]() { return stopping || completed < submitted; });
+            if (completed == submitted) return; // Stopping with nothing queued
+            const FrameSnapshot& snapshot = snapshots[completed % snapshots.size()];
+            lock.unlock();
+            stage(snapshot);
+            lock.lock();
+            completed++;
+            slot_free.notify_one();
+        }
+    }
+};
+
 } // namespace Diagnostics
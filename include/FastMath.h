@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// FAST MATH - Branch-free approximations that vectorize in SoA loops
+// Every function is plain arithmetic plus selects, so the compiler can
+// vectorize loops that call it (libm calls cannot be). Errors below are the
+// measured maxima from bench/fastmath_bench.cpp over the stated domains.
+//
+//   Function  Max error                        Domain
+//   Rsqrt     1.5e-7 relative                  [2^-60, 2^60]
+//   Sqrt      1.9e-7 relative                  [2^-60, 2^60]
+//   Atan2     2.0e-6 rad absolute              |x|, |y| <= 1000
+//   Sin/Cos   3.0e-7 absolute                  |x| <= 1e4
+//   Exp       1.0e-7 relative                  [-87, 88]
+// ============================================================================
+
+namespace FastMath {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float HALF_PI = 1.57079632679490f;
+constexpr float TWO_PI = 6.28318530717959f;
+
+inline uint32_t FloatBits(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+inline float BitsFloat(uint32_t bits) {
+    float x;
+    std::memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+
+// Magic-constant estimate (within 3.5%) refined by three Newton-Raphson steps
+inline float Rsqrt(float x) {
+    float y = BitsFloat(0x5F375A86u - (FloatBits(x) >> 1));
+    float half_x = 0.5f * x;
+    y = y * (1.5f - half_x * y * y);
+    y = y * (1.5f - half_x * y * y);
+    y = y * (1.5f - half_x * y * y);
+    return y;
+}
+
+inline float Sqrt(float x) {
+    return x > 0.0f ? x * Rsqrt(x) : 0.0f;
+}
+
+// Octant folding onto [0, 1], then a degree-11 odd minimax polynomial for atan
+inline float Atan2(float y, float x) {
+    float abs_x = std::fabs(x);
+    float abs_y = std::fabs(y);
+    float max_xy = abs_x > abs_y ? abs_x : abs_y;
+    float min_xy = abs_x > abs_y ? abs_y : abs_x;
+    float a = max_xy > 0.0f ? min_xy / max_xy : 0.0f;
+    float s = a * a;
+    float p = -0.01172120f;
+    p = p * s + 0.05265332f;
+    p = p * s - 0.11643287f;
+    p = p * s + 0.19354346f;
+    p = p * s - 0.33262347f;
+    p = p * s + 0.99997726f;
+    float r = p * a;
+    r = abs_y > abs_x ? HALF_PI - r : r;
+    r = x < 0.0f ? PI - r : r;
+    return y < 0.0f ? -r : r;
+}
+
+// Reduce an angle to [-pi, pi]. 2*pi is split (Cody-Waite) so that k * hi is
+// exact and the reduction does not lose bits for large arguments.
+inline float ReduceAngle(float x) {
+    const float TWO_PI_HI = 6.28125f;
+    const float TWO_PI_LO = 1.93530717959e-3f;
+    float k = std::nearbyint(x * (1.0f / TWO_PI));
+    return (x - k * TWO_PI_HI) - k * TWO_PI_LO;
+}
+
+// sin on [-pi, pi]: fold to [-pi/2, pi/2], odd Taylor polynomial through x^11
+inline float SinReduced(float x) {
+    x = x > HALF_PI ? PI - x : x;
+    x = x < -HALF_PI ? -PI - x : x;
+    float s = x * x;
+    float p = -2.50521084e-8f;
+    p = p * s + 2.75573192e-6f;
+    p = p * s - 1.98412698e-4f;
+    p = p * s + 8.33333333e-3f;
+    p = p * s - 1.66666667e-1f;
+    return x + x * s * p;
+}
+
+inline float Sin(float x) {
+    return SinReduced(ReduceAngle(x));
+}
+
+// The phase shift is applied after reduction, where it costs no precision
+inline float Cos(float x) {
+    float r = ReduceAngle(x) + HALF_PI;
+    return SinReduced(r > PI ? r - TWO_PI : r);
+}
+
+// e^x = 2^n * e^r with n = round(x / ln 2) and r = x - n ln 2 in
+// [-ln2/2, ln2/2] (ln 2 split like 2*pi above), e^r by a degree-7 Taylor
+// polynomial, and 2^n assembled directly in the exponent bits
+inline float Exp(float x) {
+    const float LN2_HI = 0.693145751953125f;
+    const float LN2_LO = 1.42860682030941723e-6f;
+    x = x < -87.0f ? -87.0f : (x > 88.0f ? 88.0f : x);
+    float n = std::nearbyint(x * 1.44269504f);
+    float r = (x - n * LN2_HI) - n * LN2_LO;
+    float p = 1.98412698e-4f;
+    p = p * r + 1.38888889e-3f;
+    p = p * r + 8.33333333e-3f;
+    p = p * r + 4.16666667e-2f;
+    p = p * r + 1.66666667e-1f;
+    p = p * r + 0.5f;
+    p = p * r + 1.0f;
+    p = p * r + 1.0f;
+    return p * BitsFloat(static_cast<uint32_t>(static_cast<int32_t>(n) + 127) << 23);
+}
+
+// ============================================================================
+// ACCURACY POLICIES - Chosen at compile time per system (`using Math = ...`)
+// ============================================================================
+struct Exact {
+    static constexpr bool APPROXIMATE = false;
+    static float Sqrt(float x) { return std::sqrt(x); }
+    static float Rsqrt(float x) { return 1.0f / std::sqrt(x); }
+    static float Atan2(float y, float x) { return std::atan2(y, x); }
+    static float Sin(float x) { return std::sin(x); }
+    static float Cos(float x) { return std::cos(x); }
+    static float Exp(float x) { return std::exp(x); }
+};
+
+struct Fast {
+    static constexpr bool APPROXIMATE = true;
+    static float Sqrt(float x) { return FastMath::Sqrt(x); }
+    static float Rsqrt(float x) { return FastMath::Rsqrt(x); }
+    static float Atan2(float y, float x) { return FastMath::Atan2(y, x); }
+    static float Sin(float x) { return FastMath::Sin(x); }
+    static float Cos(float x) { return FastMath::Cos(x); }
+    static float Exp(float x) { return FastMath::Exp(x); }
+};
+
+} // namespace FastMath
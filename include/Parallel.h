@@ -0,0 +1,487 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+// ============================================================================
+// PARALLEL - Work-stealing job system shared by every system
+// One deque per thread. A thread pushes and pops its own jobs at the back
+// (newest first, still hot in cache) and steals from the front of others'
+// deques when it runs dry. Threads that wait on a job group run jobs
+// meanwhile, so nested parallel work never deadlocks. Idle workers sleep.
+// ============================================================================
+
+namespace Parallel {
+
+// Jobs submitted together; Wait() returns once all of them have run
+struct JobGroup {
+    std::atomic<size_t> pending{0};
+};
+
+// ============================================================================
+// AFFINITY - Where workers run and where their memory comes from
+// Left alone, the OS migrates workers between cores and chunks land on
+// whichever worker grabs them first, so a chunk's slice of the SoA arrays
+// is rarely in the cache of the core that touches it next frame.
+// ============================================================================
+
+struct Affinity {
+    bool pin_workers = false;   // Each worker thread stays on one CPU
+    bool bind_numa = false;     // Pinned workers prefer memory from their CPU's NUMA node
+    bool stable_chunks = false; // For() chunk c always runs on worker 1 + c % (ThreadCount() - 1)
+    std::vector<int> cpus;      // CPUs in worker order; empty = every CPU this process may use
+};
+
+// CPUs this process may run on, ascending
+inline std::vector<int> AvailableCpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    return cpus;
+}
+
+// NUMA node of a CPU, from sysfs (-1 if unknown, e.g. not Linux)
+inline int NodeOfCpu(int cpu) {
+    for (int node = 0; node < 1024; ++node) {
+        std::ifstream list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!list) break;
+        // Comma-separated ranges such as "0-3,8-11"
+        std::string range;
+        while (std::getline(list, range, ',')) {
+            if (range.empty() || range[0] < '0' || range[0] > '9') continue;
+            const size_t dash = range.find('-');
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            if (cpu >= first && cpu <= last) return node;
+        }
+    }
+    return -1;
+}
+
+inline bool PinCurrentThread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// MPOL_PREFERRED for this thread: its new pages come from `node` while the
+// node has room. That covers the thread's own allocations only; arrays the
+// main thread already touched are moved by MovePagesToNode(). Direct
+// system calls, so no libnuma; on failure the default (first touch) stays.
+inline bool PreferNodeForCurrentThread(int node) {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    if (node < 0 || node >= 64) return false;
+    const int MPOL_PREFERRED_MODE = 1;
+    unsigned long mask = 1ul << node;
+    return syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, &mask, 64ul) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+// Move the pages that start inside [data, data + bytes) to `node` and keep
+// them there (mbind with MPOL_PREFERRED and MPOL_MF_MOVE). Consecutive
+// ranges of one array thus split its pages between them without overlap.
+inline bool MovePagesToNode(const void* data, size_t bytes, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (node < 0 || node >= 64) return false;
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + page - 1) / page * page;
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + bytes + page - 1) / page * page;
+    if (end <= begin) return false;
+    const int MPOL_PREFERRED_MODE = 1;
+    const unsigned MPOL_MF_MOVE_FLAG = 1u << 1;
+    unsigned long mask = 1ul << node;
+    return syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED_MODE, &mask, 64ul, MPOL_MF_MOVE_FLAG) == 0;
+#else
+    (void)data;
+    (void)bytes;
+    (void)node;
+    return false;
+#endif
+}
+
+class JobSystem {
+public:
+    // thread_count counts the calling thread; 0 = hardware concurrency.
+    // The calling thread is never pinned: threads it starts later would
+    // inherit its single-CPU mask. It alone shares the pool through queue 0;
+    // any other outside thread runs its parallel work in place.
+    explicit JobSystem(size_t thread_count = 0, Affinity affinity_config = {})
+        : affinity(std::move(affinity_config)), owner_thread(std::this_thread::get_id()) {
+        if (thread_count == 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+        if (affinity.pin_workers && affinity.cpus.empty()) affinity.cpus = AvailableCpus();
+        worker_nodes.assign(thread_count, -1);
+        queues.reserve(thread_count);
+        for (size_t q = 0; q < thread_count; ++q) queues.push_back(std::make_unique<WorkQueue>());
+        workers.reserve(thread_count - 1);
+        for (size_t w = 1; w < thread_count; ++w) {
+            workers.emplace_back([this, w]() { WorkerLoop(w); });
+        }
+        // Placement is done once the constructor returns
+        while (placed_workers.load() < workers.size()) std::this_thread::yield();
+    }
+
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    size_t ThreadCount() const { return queues.size(); }
+    const Affinity& GetAffinity() const { return affinity; }
+    size_t PinnedWorkers() const { return pinned_workers.load(); }
+    size_t BoundWorkers() const { return bound_workers.load(); }
+
+    // With stable chunks and NUMA binding, move each `grain`-row chunk of an
+    // array to the node of the worker that runs that chunk. The main thread
+    // already touched every page, so without this the data stays on its
+    // node. Call after the array is allocated or grown; returns the chunks
+    // moved.
+    size_t PlaceRows(const void* data, size_t row_bytes, size_t rows, size_t grain) const {
+        if (!affinity.stable_chunks || !affinity.bind_numa || rows == 0) return 0;
+        grain = std::max<size_t>(1, grain);
+        const char* base = static_cast<const char*>(data);
+        size_t placed = 0;
+        for (size_t chunk = 0; chunk * grain < rows; ++chunk) {
+            const int node = worker_nodes[StableWorker(chunk)];
+            if (node < 0) continue;
+            const size_t begin = chunk * grain;
+            const size_t end = std::min(rows, begin + grain);
+            if (MovePagesToNode(base + begin * row_bytes, (end - begin) * row_bytes, node)) placed++;
+        }
+        return placed;
+    }
+    
+    // True when parallel work started on this thread should run in place
+    bool RunsInline() const { return ThreadCount() == 1 || SerialDepth() > 0 || IsOutsider(); }
+    
+    // Jobs that are already small (e.g. a batch of small worlds) run their
+    // nested parallel work in place while one of these is alive, instead of
+    // paying to split it further
+    static size_t& SerialDepth() {
+        thread_local size_t depth = 0;
+        return depth;
+    }
+
+    void Submit(JobGroup& group, std::function<void()> job) {
+        if (IsOutsider()) {
+            job(); // Not the pool's thread: queue 0 is not ours to share
+            return;
+        }
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        WorkQueue& queue = *queues[LocalQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back({std::move(job), &group});
+        }
+        // Sequentially consistent with the sleeper's increment-then-check,
+        // so either it sees the job or we see it sleeping
+        queued.fetch_add(1);
+        if (sleeping.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            wake.notify_one();
+        }
+    }
+
+    // A job only thread `worker` may run (0 = the owning thread); never stolen
+    void SubmitTo(size_t worker, JobGroup& group, std::function<void()> job) {
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        WorkQueue& queue = *queues[worker];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.owned_jobs.push_back({std::move(job), &group});
+        }
+        queue.owned_count.fetch_add(1);
+        // Only that worker will do, so wake every sleeper
+        if (sleeping.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            wake.notify_all();
+        }
+    }
+
+    // Help with any queued work until the group is done
+    void Wait(JobGroup& group) {
+        if (IsOutsider()) return; // Everything it submitted already ran
+        const size_t self = LocalQueue();
+        while (group.pending.load(std::memory_order_acquire) > 0) {
+            if (!RunOne(self)) std::this_thread::yield();
+        }
+    }
+
+    // fn(chunk_begin, chunk_end) over consecutive `grain`-sized chunks of
+    // [begin, end). Chunk boundaries depend only on `grain`, never on the
+    // thread count; with one thread (or one chunk, or inside a SerialScope)
+    // fn sees the whole range. With stable_chunks, chunk c always runs on
+    // the same worker thread, frame after frame (never the calling thread,
+    // which has no fixed core).
+    template <typename Fn>
+    void For(size_t begin, size_t end, size_t grain, Fn&& fn) {
+        if (end <= begin) return;
+        grain = std::max<size_t>(1, grain);
+        const size_t chunk_count = (end - begin + grain - 1) / grain;
+        if (RunsInline() || chunk_count == 1) {
+            fn(begin, end);
+            return;
+        }
+
+        if (affinity.stable_chunks) {
+            // Same chunk, same worker: its rows are still in that core's cache
+            JobGroup group;
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                size_t chunk_begin = begin + chunk * grain;
+                size_t chunk_end = std::min(end, chunk_begin + grain);
+                SubmitTo(StableWorker(chunk), group, [&fn, chunk_begin, chunk_end]() { fn(chunk_begin, chunk_end); });
+            }
+            Wait(group);
+            return;
+        }
+
+        JobGroup group;
+        for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+            size_t chunk_begin = begin + chunk * grain;
+            size_t chunk_end = std::min(end, chunk_begin + grain);
+            Submit(group, [&fn, chunk_begin, chunk_end]() { fn(chunk_begin, chunk_end); });
+        }
+        fn(begin, std::min(end, begin + grain)); // First chunk on the calling thread
+        Wait(group);
+    }
+
+private:
+    struct Job {
+        std::function<void()> run;
+        JobGroup* group;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::deque<Job> owned_jobs; // From SubmitTo(): this queue's thread only
+        std::atomic<size_t> owned_count{0};
+    };
+
+    Affinity affinity;
+    std::atomic<size_t> pinned_workers{0};
+    std::atomic<size_t> bound_workers{0};
+    std::atomic<size_t> placed_workers{0};
+    std::vector<int> worker_nodes; // NUMA node per queue once bound, -1 = unknown
+    std::thread::id owner_thread;                   // Built the pool; the only user of queue 0
+    std::vector<std::unique_ptr<WorkQueue>> queues; // [0] belongs to owner_thread
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> sleeping{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    static size_t& WorkerIndex() {
+        thread_local size_t index = 0;
+        return index;
+    }
+
+    size_t LocalQueue() const { return std::min(WorkerIndex(), queues.size() - 1); }
+
+    // A thread that is neither a worker nor the pool's owner, e.g. a
+    // background diagnostics thread
+    bool IsOutsider() const { return WorkerIndex() == 0 && std::this_thread::get_id() != owner_thread; }
+
+    // Worker that runs stable chunk `chunk`; workers are pinned and may be
+    // NUMA-bound, the owning thread is neither
+    size_t StableWorker(size_t chunk) const {
+        return ThreadCount() == 1 ? 0 : 1 + chunk % (ThreadCount() - 1);
+    }
+
+    bool TakeLocal(size_t self, Job& job) {
+        WorkQueue& queue = *queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) return false;
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool Steal(size_t self, Job& job) {
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            WorkQueue& victim = *queues[(self + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.jobs.empty()) continue;
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool TakeOwned(size_t self, Job& job) {
+        WorkQueue& queue = *queues[self];
+        if (queue.owned_count.load(std::memory_order_acquire) == 0) return false;
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.owned_jobs.empty()) return false;
+        job = std::move(queue.owned_jobs.front());
+        queue.owned_jobs.pop_front();
+        queue.owned_count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool RunOne(size_t self) {
+        Job job;
+        if (!TakeOwned(self, job)) {
+            if (queued.load(std::memory_order_acquire) == 0) return false;
+            if (!TakeLocal(self, job) && !Steal(self, job)) return false;
+            queued.fetch_sub(1, std::memory_order_relaxed);
+        }
+        job.run();
+        job.group->pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void PlaceWorker(size_t index) {
+        if (affinity.pin_workers && !affinity.cpus.empty()) {
+            const int cpu = affinity.cpus[index % affinity.cpus.size()];
+            if (PinCurrentThread(cpu)) {
+                pinned_workers.fetch_add(1);
+                const int node = NodeOfCpu(cpu);
+                if (affinity.bind_numa && PreferNodeForCurrentThread(node)) {
+                    worker_nodes[index] = node;
+                    bound_workers.fetch_add(1);
+                }
+            }
+        }
+        placed_workers.fetch_add(1);
+    }
+
+    void WorkerLoop(size_t index) {
+        WorkerIndex() = index;
+        PlaceWorker(index);
+        WorkQueue& own = *queues[index];
+        while (true) {
+            if (RunOne(index)) continue;
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleeping.fetch_add(1);
+            wake.wait(lock, [this, &own]() { return stopping || queued.load() > 0 || own.owned_count.load() > 0; });
+            sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (stopping) return;
+        }
+    }
+};
+
+// ============================================================================
+// SHARED POOL - Sized once, on first use or by an earlier Configure()
+// ============================================================================
+
+inline std::unique_ptr<JobSystem>& PoolStorage() {
+    static std::unique_ptr<JobSystem> pool;
+    return pool;
+}
+
+// Choose the thread count (0 = hardware concurrency) and placement. Call
+// before any parallel work, from the main thread.
+inline void Configure(size_t thread_count, const Affinity& affinity = {}) {
+    PoolStorage().reset(); // Old workers leave first, so their CPUs are free
+    PoolStorage() = std::make_unique<JobSystem>(thread_count, affinity);
+}
+
+inline JobSystem& Pool() {
+    std::unique_ptr<JobSystem>& pool = PoolStorage();
+    if (!pool) pool = std::make_unique<JobSystem>();
+    return *pool;
+}
+
+inline size_t ThreadCount() {
+    return Pool().ThreadCount();
+}
+
+inline bool RunsInline() {
+    return Pool().RunsInline();
+}
+
+// PlaceRows() for one column of `rows` entities
+template <typename Column>
+size_t PlaceColumn(const Column& column, size_t rows, size_t grain) {
+    return Pool().PlaceRows(column.data(), sizeof(column[0]), rows, grain);
+}
+
+struct SerialScope {
+    SerialScope() { JobSystem::SerialDepth()++; }
+    ~SerialScope() { JobSystem::SerialDepth()--; }
+    SerialScope(const SerialScope&) = delete;
+    SerialScope& operator=(const SerialScope&) = delete;
+};
+
+template <typename Fn>
+void For(size_t begin, size_t end, size_t grain, Fn&& fn) {
+    Pool().For(begin, end, grain, std::forward<Fn>(fn));
+}
+
+// Deterministic reduction: map(chunk_begin, chunk_end) runs per fixed
+// `grain`-sized chunk (in parallel), and the partials are folded left to
+// right on the calling thread. Chunking and fold order never depend on the
+// thread count, so neither does the result, even for floating point.
+template <typename T, typename Map, typename Combine>
+T ReduceOrdered(size_t begin, size_t end, size_t grain, T result, Map&& map, Combine&& combine) {
+    if (end <= begin) return result;
+    grain = std::max<size_t>(1, grain);
+    const size_t chunk_count = (end - begin + grain - 1) / grain;
+    std::vector<T> partials(chunk_count);
+    For(0, chunk_count, 1, [&](size_t first, size_t last) {
+        for (size_t chunk = first; chunk < last; ++chunk) {
+            size_t chunk_begin = begin + chunk * grain;
+            partials[chunk] = map(chunk_begin, std::min(end, chunk_begin + grain));
+        }
+    });
+    for (const T& partial : partials) result = combine(result, partial);
+    return result;
+}
+
+inline void Submit(JobGroup& group, std::function<void()> job) {
+    Pool().Submit(group, std::move(job));
+}
+
+inline void Wait(JobGroup& group) {
+    Pool().Wait(group);
+}
+
+} // namespace Parallel
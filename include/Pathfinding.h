@@ -0,0 +1,364 @@
+#pragma once
+
+#include "Components.h"
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+// ============================================================================
+// PATHFINDING - Searches over the obstacle map and the cluster graph
+// Cells are indexed x * GRID_SIZE + y (SpatialGrid::CellIndex). Moves are
+// 8-connected, cost 10 straight and 14 diagonal, and never cut the corner of
+// a blocked cell. Every function here only reads shared data, so requests can
+// be served from any thread.
+// ============================================================================
+
+namespace Pathfinding {
+
+using Grid = GameState::SpatialGrid;
+using Obstacles = GameState::ObstacleMap;
+using Service = GameState::PathfindingService;
+
+constexpr uint32_t STRAIGHT_COST = 10;
+constexpr uint32_t DIAGONAL_COST = 14;
+constexpr uint32_t NO_PATH = UINT32_MAX;
+
+// Neighbour offsets; odd directions are diagonal
+constexpr int OFFSET_X[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+constexpr int OFFSET_Y[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+inline int CellX(int cell) { return cell / Grid::GRID_SIZE; }
+inline int CellY(int cell) { return cell % Grid::GRID_SIZE; }
+inline int CellAt(int x, int y) { return x * Grid::GRID_SIZE + y; }
+
+inline Waypoint CellCenter(int cell) {
+    return {(static_cast<float>(CellX(cell)) + 0.5f) * Grid::CELL_SIZE,
+            (static_cast<float>(CellY(cell)) + 0.5f) * Grid::CELL_SIZE};
+}
+
+inline int ClusterOf(int cell) {
+    return (CellX(cell) / Service::CLUSTER_SIZE) * Service::CLUSTERS_PER_SIDE +
+           CellY(cell) / Service::CLUSTER_SIZE;
+}
+
+// Inclusive cell rectangle a search may not leave
+struct Bounds {
+    int min_x, min_y, max_x, max_y;
+};
+
+inline Bounds WholeGrid() {
+    return {0, 0, Grid::GRID_SIZE - 1, Grid::GRID_SIZE - 1};
+}
+
+inline Bounds ClusterBounds(int cluster) {
+    int x = (cluster / Service::CLUSTERS_PER_SIDE) * Service::CLUSTER_SIZE;
+    int y = (cluster % Service::CLUSTERS_PER_SIDE) * Service::CLUSTER_SIZE;
+    return {x, y, x + Service::CLUSTER_SIZE - 1, y + Service::CLUSTER_SIZE - 1};
+}
+
+inline bool CanStep(const Obstacles& obstacles, int x, int y, int direction) {
+    int nx = x + OFFSET_X[direction];
+    int ny = y + OFFSET_Y[direction];
+    if (obstacles.IsBlocked(nx, ny)) return false;
+    if (direction & 1) return !obstacles.IsBlocked(nx, y) && !obstacles.IsBlocked(x, ny);
+    return true;
+}
+
+inline uint32_t OctileDistance(int from, int to) {
+    uint32_t dx = static_cast<uint32_t>(std::abs(CellX(from) - CellX(to)));
+    uint32_t dy = static_cast<uint32_t>(std::abs(CellY(from) - CellY(to)));
+    uint32_t diagonal = std::min(dx, dy);
+    return STRAIGHT_COST * (std::max(dx, dy) - diagonal) + DIAGONAL_COST * diagonal;
+}
+
+// A* from `start` to `goal` without leaving `bounds`. On success returns the
+// cost and, if `path` is given, appends the cells after `start` through
+// `goal`. Returns NO_PATH otherwise.
+inline uint32_t FindCellPath(const Obstacles& obstacles, int start, int goal,
+                             const Bounds& bounds, std::vector<int32_t>* path) {
+    if (start == goal) return 0;
+    if (obstacles.IsBlocked(CellX(goal), CellY(goal))) return NO_PATH;
+    
+    // Per-thread scratch, reset in O(1) by bumping the generation stamp
+    struct Scratch {
+        std::vector<uint32_t> cost;
+        std::vector<int32_t> parent;
+        std::vector<uint32_t> stamp;
+        uint32_t generation = 0;
+    };
+    thread_local Scratch scratch;
+    if (scratch.stamp.empty()) {
+        scratch.cost.resize(Grid::CELL_COUNT);
+        scratch.parent.resize(Grid::CELL_COUNT);
+        scratch.stamp.resize(Grid::CELL_COUNT, 0);
+    }
+    if (++scratch.generation == 0) {
+        std::fill(scratch.stamp.begin(), scratch.stamp.end(), 0);
+        scratch.generation = 1;
+    }
+    auto cost_of = [](int cell) {
+        return scratch.stamp[cell] == scratch.generation ? scratch.cost[cell] : NO_PATH;
+    };
+    
+    using Entry = std::pair<uint32_t, int>; // (estimated total, cell)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    scratch.stamp[start] = scratch.generation;
+    scratch.cost[start] = 0;
+    scratch.parent[start] = -1;
+    open.push({OctileDistance(start, goal), start});
+    
+    while (!open.empty()) {
+        auto [estimate, cell] = open.top();
+        open.pop();
+        uint32_t cost = scratch.cost[cell];
+        if (estimate != cost + OctileDistance(cell, goal)) continue; // Superseded entry
+        
+        if (cell == goal) {
+            if (path) {
+                size_t first = path->size();
+                for (int step = goal; step != start; step = scratch.parent[step]) path->push_back(step);
+                std::reverse(path->begin() + static_cast<std::ptrdiff_t>(first), path->end());
+            }
+            return cost;
+        }
+        
+        int x = CellX(cell);
+        int y = CellY(cell);
+        for (int d = 0; d < 8; ++d) {
+            int nx = x + OFFSET_X[d];
+            int ny = y + OFFSET_Y[d];
+            if (nx < bounds.min_x || nx > bounds.max_x || ny < bounds.min_y || ny > bounds.max_y) continue;
+            if (!CanStep(obstacles, x, y, d)) continue;
+            int next = CellAt(nx, ny);
+            uint32_t next_cost = cost + ((d & 1) ? DIAGONAL_COST : STRAIGHT_COST);
+            if (next_cost < cost_of(next)) {
+                scratch.stamp[next] = scratch.generation;
+                scratch.cost[next] = next_cost;
+                scratch.parent[next] = cell;
+                open.push({next_cost + OctileDistance(next, goal), next});
+            }
+        }
+    }
+    return NO_PATH;
+}
+
+// Whether the segment between two world points crosses only open cells.
+// Passing exactly through a cell corner requires both side cells open, the
+// same rule CanStep applies to diagonal moves.
+inline bool LineOfSight(const Obstacles& obstacles, float x0, float y0, float x1, float y1) {
+    const float limit = static_cast<float>(Grid::GRID_SIZE) - 1e-3f;
+    auto to_grid = [limit](float v) { return std::max(0.0f, std::min(limit, v / Grid::CELL_SIZE)); };
+    float gx0 = to_grid(x0), gy0 = to_grid(y0);
+    float gx1 = to_grid(x1), gy1 = to_grid(y1);
+    int cx = static_cast<int>(gx0), cy = static_cast<int>(gy0);
+    const int end_x = static_cast<int>(gx1), end_y = static_cast<int>(gy1);
+    if (obstacles.IsBlocked(cx, cy)) return false;
+    
+    // Grid traversal (Amanatides & Woo): step into whichever cell boundary
+    // the segment crosses first
+    const float infinity = std::numeric_limits<float>::infinity();
+    const float dx = gx1 - gx0, dy = gy1 - gy0;
+    const int step_x = dx > 0.0f ? 1 : -1;
+    const int step_y = dy > 0.0f ? 1 : -1;
+    const float delta_x = dx != 0.0f ? std::abs(1.0f / dx) : infinity;
+    const float delta_y = dy != 0.0f ? std::abs(1.0f / dy) : infinity;
+    float next_x = dx != 0.0f ? (dx > 0.0f ? (std::floor(gx0) + 1.0f - gx0) : (gx0 - std::floor(gx0))) * delta_x : infinity;
+    float next_y = dy != 0.0f ? (dy > 0.0f ? (std::floor(gy0) + 1.0f - gy0) : (gy0 - std::floor(gy0))) * delta_y : infinity;
+    
+    int remaining = std::abs(end_x - cx) + std::abs(end_y - cy);
+    while (remaining > 0) {
+        if (next_x < next_y) {
+            cx += step_x;
+            next_x += delta_x;
+            remaining--;
+        } else if (next_y < next_x) {
+            cy += step_y;
+            next_y += delta_y;
+            remaining--;
+        } else {
+            if (obstacles.IsBlocked(cx + step_x, cy) || obstacles.IsBlocked(cx, cy + step_y)) return false;
+            cx += step_x;
+            cy += step_y;
+            next_x += delta_x;
+            next_y += delta_y;
+            remaining -= 2;
+        }
+        if (obstacles.IsBlocked(cx, cy)) return false;
+    }
+    return true;
+}
+
+// Turn a cell path into the few corners a straight-line mover needs: from
+// each anchor, jump to the furthest cell still in sight
+inline void SmoothPath(const Obstacles& obstacles, float from_x, float from_y,
+                       const std::vector<int32_t>& cells, std::vector<Waypoint>& waypoints) {
+    waypoints.clear();
+    Waypoint anchor = {from_x, from_y};
+    size_t next = 0;
+    while (next < cells.size()) {
+        size_t furthest = next;
+        for (size_t k = next + 1; k < cells.size(); ++k) {
+            Waypoint candidate = CellCenter(cells[k]);
+            if (!LineOfSight(obstacles, anchor.x, anchor.y, candidate.x, candidate.y)) break;
+            furthest = k;
+        }
+        anchor = CellCenter(cells[furthest]);
+        waypoints.push_back(anchor);
+        next = furthest + 1;
+    }
+}
+
+// Abstract graph over cluster entrances. Each maximal run of open cell pairs
+// along a cluster border becomes one entrance at its middle; nodes in the
+// same cluster are linked by their in-cluster path cost.
+inline void BuildGraph(const Obstacles& obstacles, Service::Graph& graph) {
+    graph.node_cell.clear();
+    graph.edges.clear();
+    graph.cluster_nodes.assign(Service::CLUSTER_COUNT, {});
+    
+    auto add_node = [&graph](int cell) {
+        std::vector<uint32_t>& nodes = graph.cluster_nodes[ClusterOf(cell)];
+        for (uint32_t node : nodes) {
+            if (graph.node_cell[node] == cell) return node;
+        }
+        uint32_t node = static_cast<uint32_t>(graph.node_cell.size());
+        graph.node_cell.push_back(cell);
+        graph.edges.emplace_back();
+        nodes.push_back(node);
+        return node;
+    };
+    auto add_entrance = [&](int inside, int outside) {
+        uint32_t a = add_node(inside);
+        uint32_t b = add_node(outside);
+        graph.edges[a].push_back({b, STRAIGHT_COST});
+        graph.edges[b].push_back({a, STRAIGHT_COST});
+    };
+    
+    for (int border = Service::CLUSTER_SIZE; border < Grid::GRID_SIZE; border += Service::CLUSTER_SIZE) {
+        for (int vertical = 0; vertical < 2; ++vertical) {
+            // Cells on either side of the border at position `along`
+            auto inside = [&](int along) { return vertical ? CellAt(border - 1, along) : CellAt(along, border - 1); };
+            auto outside = [&](int along) { return vertical ? CellAt(border, along) : CellAt(along, border); };
+            
+            int run_start = -1;
+            for (int along = 0; along <= Grid::GRID_SIZE; ++along) {
+                bool open = along < Grid::GRID_SIZE &&
+                    !obstacles.blocked[inside(along)] && !obstacles.blocked[outside(along)];
+                // Runs end at blocked cells and at cluster corners
+                if (run_start >= 0 && (!open || along % Service::CLUSTER_SIZE == 0)) {
+                    int middle = (run_start + along - 1) / 2;
+                    add_entrance(inside(middle), outside(middle));
+                    run_start = -1;
+                }
+                if (open && run_start < 0) run_start = along;
+            }
+        }
+    }
+    
+    for (int cluster = 0; cluster < Service::CLUSTER_COUNT; ++cluster) {
+        const Bounds bounds = ClusterBounds(cluster);
+        const std::vector<uint32_t>& nodes = graph.cluster_nodes[cluster];
+        for (size_t a = 0; a < nodes.size(); ++a) {
+            for (size_t b = a + 1; b < nodes.size(); ++b) {
+                uint32_t cost = FindCellPath(obstacles, graph.node_cell[nodes[a]], graph.node_cell[nodes[b]],
+                                             bounds, nullptr);
+                if (cost == NO_PATH) continue;
+                graph.edges[nodes[a]].push_back({nodes[b], cost});
+                graph.edges[nodes[b]].push_back({nodes[a], cost});
+            }
+        }
+    }
+    graph.version = obstacles.version;
+}
+
+inline uint32_t RouteKey(int start_cluster, int goal_cluster) {
+    return static_cast<uint32_t>(start_cluster) * Service::CLUSTER_COUNT + static_cast<uint32_t>(goal_cluster);
+}
+
+// Cheapest entrance chain leaving `from` and entering `to`, refined into
+// cells (first entrance cell included). Shared by every request between the
+// two clusters; empty when they are not connected.
+inline std::vector<int32_t> FindClusterRoute(const Obstacles& obstacles, const Service::Graph& graph,
+                                             int from, int to) {
+    const size_t node_count = graph.node_cell.size();
+    std::vector<uint32_t> cost(node_count, NO_PATH);
+    std::vector<int32_t> parent(node_count, -1);
+    
+    // Dijkstra seeded with every entrance of the start cluster
+    using Entry = std::pair<uint32_t, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    for (uint32_t node : graph.cluster_nodes[from]) {
+        cost[node] = 0;
+        open.push({0, node});
+    }
+    
+    int32_t reached = -1;
+    while (!open.empty()) {
+        auto [node_cost, node] = open.top();
+        open.pop();
+        if (node_cost != cost[node]) continue;
+        if (ClusterOf(graph.node_cell[node]) == to) {
+            reached = static_cast<int32_t>(node);
+            break;
+        }
+        for (const Service::Edge& edge : graph.edges[node]) {
+            uint32_t next_cost = node_cost + edge.cost;
+            if (next_cost < cost[edge.to]) {
+                cost[edge.to] = next_cost;
+                parent[edge.to] = static_cast<int32_t>(node);
+                open.push({next_cost, edge.to});
+            }
+        }
+    }
+    
+    std::vector<int32_t> cells;
+    if (reached < 0) return cells;
+    
+    std::vector<uint32_t> chain;
+    for (int32_t node = reached; node >= 0; node = parent[node]) chain.push_back(static_cast<uint32_t>(node));
+    std::reverse(chain.begin(), chain.end());
+    
+    cells.push_back(graph.node_cell[chain[0]]);
+    for (size_t k = 1; k < chain.size(); ++k) {
+        int a = graph.node_cell[chain[k - 1]];
+        int b = graph.node_cell[chain[k]];
+        if (ClusterOf(a) == ClusterOf(b)) {
+            FindCellPath(obstacles, a, b, ClusterBounds(ClusterOf(a)), &cells);
+        } else {
+            cells.push_back(b); // Crossing an entrance
+        }
+    }
+    return cells;
+}
+
+// Full cell path for one request: local legs inside the start and goal
+// clusters joined by the shared cluster route. A start or goal in a pocket
+// the shared route cannot reach falls back to a flat search.
+inline bool AssemblePath(const Obstacles& obstacles, int start, int goal,
+                         const std::vector<int32_t>& cluster_route, std::vector<int32_t>& cells) {
+    cells.clear();
+    const int start_cluster = ClusterOf(start);
+    const int goal_cluster = ClusterOf(goal);
+    
+    if (start_cluster == goal_cluster) {
+        if (FindCellPath(obstacles, start, goal, ClusterBounds(start_cluster), &cells) != NO_PATH) return true;
+        cells.clear();
+    } else {
+        if (cluster_route.empty()) return false; // No entrance chain connects the clusters
+        if (FindCellPath(obstacles, start, cluster_route.front(), ClusterBounds(start_cluster), &cells) != NO_PATH) {
+            cells.insert(cells.end(), cluster_route.begin() + 1, cluster_route.end());
+            if (FindCellPath(obstacles, cluster_route.back(), goal, ClusterBounds(goal_cluster), &cells) != NO_PATH) {
+                return true;
+            }
+        }
+        cells.clear();
+    }
+    return FindCellPath(obstacles, start, goal, WholeGrid(), &cells) != NO_PATH;
+}
+
+} // namespace Pathfinding
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "Components.h"
+#include "Diagnostics.h"
+#include "Parallel.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <chrono>
+#include <thread>
+
+// ============================================================================
+// SCHEDULER - "The Conductor"
+// Stages are registered once, in program order, with the components they
+// read and write. Every frame the enabled stages form a DAG: a stage waits
+// for each earlier stage it conflicts with (one writes what the other reads
+// or writes). Everything else is free to run at the same time on the job
+// system, so a new system only has to declare its masks honestly.
+// ============================================================================
+
+namespace Scheduling {
+
+// Not a component: standard output. Stages that print write it, so their
+// lines never interleave.
+constexpr ComponentMask CONSOLE = 1u << 31;
+
+class SystemScheduler {
+public:
+    using Condition = std::function<bool()>;
+
+    // Systems added after this write the back buffers of these components
+    // (GameState::EnableDoubleBuffering), so they stop conflicting with
+    // readers of the current frame
+    void SetDoubleBuffered(ComponentMask components) { double_buffered = components; }
+    
+    // A system's Update() with its declared masks; profiled under `name`
+    template <typename System>
+    void AddSystem(const std::string& name, GameState& state, float delta_time, Condition enabled = {}) {
+        stages.push_back({name, System::READS, Component::RedirectWrites(System::WRITES, double_buffered),
+                          [&state, delta_time]() { System::Update(state, delta_time); },
+                          std::move(enabled), true, false});
+    }
+
+    // Any other work over the state (diagnostics, checks); not profiled
+    void Add(const std::string& name, ComponentMask reads, ComponentMask writes,
+             std::function<void()> run, Condition enabled = {}) {
+        stages.push_back({name, reads, writes, std::move(run), std::move(enabled), false, false});
+    }
+
+    // Work on the finished frame that is deferred into the next one, where
+    // it overlaps that frame's first stages (e.g. logging frame N alongside
+    // perception of N + 1). It still runs before any stage that conflicts
+    // with it. Finish() runs whatever the last frame left behind.
+    void AddTrailing(const std::string& name, ComponentMask reads, ComponentMask writes,
+                     std::function<void()> run, Condition enabled = {}) {
+        stages.push_back({name, reads, writes, std::move(run), std::move(enabled), false, true});
+    }
+
+    // One frame: last frame's trailing stages first, then this frame's
+    // stages in registration order. Conditions are checked here.
+    void Run(Diagnostics::Profiler* profiler = nullptr) {
+        active.swap(carried);
+        carried.clear();
+        for (size_t s = 0; s < stages.size(); ++s) {
+            if (stages[s].enabled && !stages[s].enabled()) continue;
+            (stages[s].trailing ? carried : active).push_back(s);
+        }
+        Execute(profiler);
+    }
+
+    void Finish() {
+        active.swap(carried);
+        carried.clear();
+        Execute(nullptr);
+    }
+
+private:
+    struct Stage {
+        std::string name;
+        ComponentMask reads;
+        ComponentMask writes;
+        std::function<void()> run;
+        Condition enabled;          // Empty = every frame
+        bool profiled;
+        bool trailing;
+    };
+
+    std::vector<Stage> stages;
+    ComponentMask double_buffered = Component::NONE;
+    std::vector<size_t> active;     // Stage indices scheduled this frame, in order
+    std::vector<size_t> carried;    // Trailing stages waiting for the next frame
+    std::vector<std::vector<uint32_t>> successors; // Per active position
+    std::vector<size_t> roots;                     // Active positions with no inputs
+    std::unique_ptr<std::atomic<uint32_t>[]> unfinished_inputs;
+    size_t input_capacity = 0;
+
+    static bool Conflicts(const Stage& a, const Stage& b) {
+        return (a.writes & (b.reads | b.writes)) != 0 || (a.reads & b.writes) != 0;
+    }
+
+    void RunStage(size_t position, Diagnostics::Profiler* profiler) {
+        const Stage& stage = stages[active[position]];
+        if (profiler && stage.profiled) {
+            Diagnostics::ProfileScope scope(*profiler, stage.name);
+            stage.run();
+        } else {
+            stage.run();
+        }
+    }
+
+    void Execute(Diagnostics::Profiler* profiler) {
+        const size_t count = active.size();
+        successors.assign(count, {});
+        if (input_capacity < count) {
+            unfinished_inputs = std::make_unique<std::atomic<uint32_t>[]>(count);
+            input_capacity = count;
+        }
+        roots.clear();
+        for (size_t b = 0; b < count; ++b) {
+            uint32_t inputs = 0;
+            for (size_t a = 0; a < b; ++a) {
+                if (Conflicts(stages[active[a]], stages[active[b]])) {
+                    successors[a].push_back(static_cast<uint32_t>(b));
+                    inputs++;
+                }
+            }
+            unfinished_inputs[b].store(inputs, std::memory_order_relaxed);
+            if (inputs == 0) roots.push_back(b);
+        }
+
+        // Registration order is already a valid topological order
+        if (Parallel::RunsInline()) {
+            for (size_t position = 0; position < count; ++position) RunStage(position, profiler);
+            return;
+        }
+
+        // Roots are collected up front: once launched they start releasing
+        // successors, whose counts would then also read zero
+        Parallel::JobGroup group;
+        for (size_t position : roots) Launch(group, position, profiler);
+        Parallel::Wait(group);
+    }
+
+    // Run a ready stage, then release every successor whose last input it was
+    void Launch(Parallel::JobGroup& group, size_t position, Diagnostics::Profiler* profiler) {
+        Parallel::Submit(group, [this, &group, position, profiler]() {
+            RunStage(position, profiler);
+            for (uint32_t next : successors[position]) {
+                if (unfinished_inputs[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    Launch(group, next, profiler);
+                }
+            }
+        });
+    }
+};
+
+// ============================================================================
+// TICK DRIVER - "The Pacemaker"
+// Holds the simulation to a fixed tick rate in real time. WaitForTick()
+// sleeps (never spins) until the next tick is due; ticks that are already
+// overdue return at once so the simulation catches up, but never more than
+// `max_catch_up` in a row: beyond that the backlog is dropped and the
+// simulation runs slow instead of spiralling. Between ticks Alpha() says
+// how far real time has moved toward the next one, for consumers that
+// interpolate the last two frames.
+// ============================================================================
+
+class TickDriver {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Stats {
+        uint64_t ticks = 0;            // Ticks handed out
+        uint64_t caught_up = 0;        // Ticks that were already overdue
+        uint64_t dropped = 0;          // Overdue ticks skipped by the catch-up cap
+        double sleep_ms = 0.0;         // Total time asleep waiting for ticks
+        double max_lateness_ms = 0.0;  // Worst wake-up after a tick was due
+    };
+    
+    // Unpaced, every tick is due at once (benchmarks, offline replay)
+    TickDriver(double tick_seconds, uint32_t max_catch_up, bool paced = true)
+        : tick(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(tick_seconds))),
+          max_catch_up(max_catch_up), paced(paced) {
+        simulated_until = Clock::now();
+        next_due = simulated_until + tick;
+    }
+    
+    // Block until the next tick is due, then claim it
+    void WaitForTick() {
+        Clock::time_point now = Clock::now();
+        if (!paced) {
+            simulated_until = now;
+            stats.ticks++;
+            return;
+        }
+        
+        if (now < next_due) {
+            std::this_thread::sleep_until(next_due);
+            const Clock::time_point woke = Clock::now();
+            stats.sleep_ms += std::chrono::duration<double, std::milli>(woke - now).count();
+            now = woke;
+        } else {
+            stats.caught_up++;
+        }
+        stats.max_lateness_ms = std::max(stats.max_lateness_ms,
+            std::chrono::duration<double, std::milli>(now - next_due).count());
+        
+        // Overdue beyond the cap: forget the oldest excess. Every tick from
+        // next_due up to now is due, the one claimed here included.
+        const uint64_t due = static_cast<uint64_t>((now - next_due) / tick) + 1;
+        const uint64_t cap = std::max<uint64_t>(1, max_catch_up);
+        if (due > cap) {
+            const uint64_t drop = due - cap;
+            next_due += tick * static_cast<Clock::rep>(drop);
+            stats.dropped += drop;
+        }
+        
+        simulated_until = next_due;
+        next_due += tick;
+        stats.ticks++;
+    }
+    
+    // Share of a tick that real time is past the last simulated frame, in
+    // [0, 1]: blend previous and current frame by this much
+    float Alpha() const {
+        if (!paced) return 1.0f;
+        const double ahead = std::chrono::duration<double>(Clock::now() - simulated_until).count();
+        const double alpha = ahead / std::chrono::duration<double>(tick).count();
+        return static_cast<float>(std::max(0.0, std::min(1.0, alpha)));
+    }
+    
+    const Stats& GetStats() const { return stats; }
+    
+    // Pacing figures, printed with the profiler's report
+    void Publish(Diagnostics::Profiler& profiler) const {
+        profiler.SetStat("Ticks caught up", static_cast<double>(stats.caught_up));
+        profiler.SetStat("Ticks dropped", static_cast<double>(stats.dropped));
+        profiler.SetStat("Tick sleep avg (ms)", stats.ticks ? stats.sleep_ms / stats.ticks : 0.0);
+        profiler.SetStat("Tick lateness max (ms)", stats.max_lateness_ms);
+        profiler.SetStat("Interpolation alpha", Alpha());
+    }
+    
+private:
+    Clock::duration tick;
+    uint32_t max_catch_up;
+    bool paced;
+    Clock::time_point next_due;        // When the next tick may run
+    Clock::time_point simulated_until; // Real time the last claimed tick stands for
+    Stats stats;
+};
+
+} // namespace Scheduling
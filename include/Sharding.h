@@ -0,0 +1,510 @@
+#pragma once
+
+#include "Components.h"
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ============================================================================
+// SHARDING - "The Border Guards"
+// The world is cut into vertical strips, each simulated by its own process
+// with its own GameState. Every frame, neighbouring shards trade two kinds
+// of entity record through single-producer/single-consumer rings in POSIX
+// shared memory:
+//   - migrants: entities that crossed into the neighbour's strip. They are
+//     removed here and owned there from now on.
+//   - ghosts: read-only copies of entities within GHOST_RANGE of the
+//     border, so perception and crowd forces near it see both sides.
+// Migrants are sent in ascending entity order and received left neighbour
+// first, so the handoff is the same on every run regardless of timing.
+// ============================================================================
+
+namespace Sharding {
+
+// Strips of equal width across the world, left to right. Ghosts only reach
+// the adjacent strip, so a strip must be at least ghost_range wide.
+struct Layout {
+    size_t shard_count = 1;
+    float world_width = GameState::SpatialGrid::GRID_SIZE * GameState::SpatialGrid::CELL_SIZE;
+    float ghost_range = 100.0f; // At least the longest view range
+    
+    float StripWidth() const { return world_width / static_cast<float>(shard_count); }
+    float MinX(size_t shard) const { return StripWidth() * static_cast<float>(shard); }
+    float MaxX(size_t shard) const { return StripWidth() * static_cast<float>(shard + 1); }
+    
+    // Positions off either edge of the world belong to the nearest strip
+    size_t OwnerOf(float x) const {
+        float strip = x / StripWidth();
+        if (!(strip > 0.0f)) return 0;
+        size_t shard = static_cast<size_t>(strip);
+        return shard < shard_count ? shard : shard_count - 1;
+    }
+};
+
+// ============================================================================
+// WIRE FORMAT - One fixed-size record per entity
+// Path state is not carried: a migrant asks its new shard for a route.
+// ============================================================================
+
+enum class RecordKind : uint32_t { MIGRANT = 1, GHOST, END_OF_FRAME };
+
+struct Record {
+    RecordKind kind;
+    uint32_t global_id;      // Entity index in the unsharded world; frame number for END_OF_FRAME
+    float position[3];
+    float velocity[3];
+    float heading[2];
+    float view_range, view_angle;
+    float hunger, energy, safety, curiosity;
+    uint32_t needs_frame;    // NeedsComponents::last_update_frame
+    uint8_t danger_level;
+    ActionType action;
+    uint8_t alive;
+    uint8_t lod_tier;
+    float action_utility;
+    float target[3];
+    uint32_t decision_frame;
+    uint32_t kinetic_frame;
+    float health, max_health;
+    int32_t armor_type;
+};
+
+inline void Pack(const GameState& state, EntityID i, uint32_t global_id, RecordKind kind, Record& out) {
+    const TransformComponents& t = state.transforms;
+    out.kind = kind;
+    out.global_id = global_id;
+    out.position[0] = t.position_x[i]; out.position[1] = t.position_y[i]; out.position[2] = t.position_z[i];
+    out.velocity[0] = t.velocity_x[i]; out.velocity[1] = t.velocity_y[i]; out.velocity[2] = t.velocity_z[i];
+    out.heading[0] = t.heading_x[i]; out.heading[1] = t.heading_y[i];
+    out.view_range = state.perception.view_range[i];
+    out.view_angle = state.perception.view_angle[i];
+    out.hunger = state.needs.hunger[i];
+    out.energy = state.needs.energy[i];
+    out.safety = state.needs.safety[i];
+    out.curiosity = state.needs.curiosity[i];
+    out.needs_frame = state.needs.last_update_frame[i];
+    out.danger_level = state.needs.danger_level[i];
+    out.action = state.actions.current_action[i];
+    out.alive = state.health.is_alive[i] ? 1 : 0;
+    out.lod_tier = state.lod.tier[i];
+    out.action_utility = state.actions.action_utility[i];
+    out.target[0] = state.actions.target_x[i];
+    out.target[1] = state.actions.target_y[i];
+    out.target[2] = state.actions.target_z[i];
+    out.decision_frame = state.actions.last_decision_frame[i];
+    out.kinetic_frame = state.lod.last_kinetic_frame[i];
+    out.health = state.health.health[i];
+    out.max_health = state.health.max_health[i];
+    out.armor_type = state.health.armor_type[i];
+}
+
+// Into a freshly added row; paths keep their defaults
+inline void Unpack(const Record& in, GameState& state, EntityID i) {
+    TransformComponents& t = state.transforms;
+    state.steering.separation_x[i] = 0.0f; state.steering.separation_y[i] = 0.0f;
+    state.steering.guide_x[i] = 0.0f; state.steering.guide_y[i] = 0.0f;
+    t.position_x[i] = in.position[0]; t.position_y[i] = in.position[1]; t.position_z[i] = in.position[2];
+    t.velocity_x[i] = in.velocity[0]; t.velocity_y[i] = in.velocity[1]; t.velocity_z[i] = in.velocity[2];
+    t.heading_x[i] = in.heading[0]; t.heading_y[i] = in.heading[1];
+    state.perception.view_range[i] = in.view_range;
+    state.perception.view_angle[i] = in.view_angle;
+    state.perception.visible_entity_count[i] = 0;
+    state.perception.last_perception_frame[i] = 0;
+    state.needs.hunger[i] = in.hunger;
+    state.needs.energy[i] = in.energy;
+    state.needs.safety[i] = in.safety;
+    state.needs.curiosity[i] = in.curiosity;
+    state.needs.last_update_frame[i] = in.needs_frame;
+    state.needs.danger_level[i] = in.danger_level;
+    state.actions.current_action[i] = in.action;
+    state.actions.action_utility[i] = in.action_utility;
+    state.actions.target_entity[i] = INVALID_ENTITY;
+    state.actions.target_x[i] = in.target[0];
+    state.actions.target_y[i] = in.target[1];
+    state.actions.target_z[i] = in.target[2];
+    state.actions.last_decision_frame[i] = in.decision_frame;
+    state.lod.tier[i] = in.lod_tier;
+    state.lod.last_kinetic_frame[i] = in.kinetic_frame;
+    state.health.health[i] = in.health;
+    state.health.max_health[i] = in.max_health;
+    state.health.armor_type[i] = in.armor_type;
+    state.health.is_alive[i] = in.alive != 0;
+}
+
+// ============================================================================
+// CHANNEL - SPSC ring of records between two processes
+// Lives in shared memory: the header is followed directly by `capacity`
+// records. head and tail only ever grow; each is written by one side.
+// ============================================================================
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared-memory rings need address-free atomics");
+
+// Waiting on another process: a few yields, then short sleeps so an idle
+// shard does not hold a core. Gives up after `timeout` (a dead peer).
+class Backoff {
+public:
+    explicit Backoff(std::chrono::milliseconds timeout = std::chrono::seconds(10))
+        : deadline(std::chrono::steady_clock::now() + timeout) {}
+    
+    void Pause() {
+        if (++rounds < 64) {
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("Shard exchange timed out (neighbour process gone?)");
+        }
+    }
+
+private:
+    std::chrono::steady_clock::time_point deadline;
+    uint32_t rounds = 0;
+};
+
+struct Channel {
+    alignas(64) std::atomic<uint64_t> head;  // Records written (producer)
+    alignas(64) std::atomic<uint64_t> tail;  // Records read (consumer)
+    alignas(64) uint64_t capacity;           // Power of two
+    
+    Record* Slots() { return reinterpret_cast<Record*>(this + 1); }
+    
+    static size_t Bytes(uint64_t capacity) { return sizeof(Channel) + capacity * sizeof(Record); }
+    
+    void Push(const Record& record) {
+        const uint64_t at = head.load(std::memory_order_relaxed);
+        Backoff backoff;
+        while (at - tail.load(std::memory_order_acquire) >= capacity) backoff.Pause();
+        Slots()[at & (capacity - 1)] = record;
+        head.store(at + 1, std::memory_order_release);
+    }
+    
+    Record Pop() {
+        const uint64_t at = tail.load(std::memory_order_relaxed);
+        Backoff backoff;
+        while (head.load(std::memory_order_acquire) == at) backoff.Pause();
+        Record record = Slots()[at & (capacity - 1)];
+        tail.store(at + 1, std::memory_order_release);
+        return record;
+    }
+};
+
+// ============================================================================
+// SHARED REGION - The rings between every pair of neighbouring shards,
+// plus one result slot per shard, in a single shm_open mapping
+// ============================================================================
+
+struct ShardReport {
+    uint64_t owned = 0;
+    uint64_t alive = 0;
+    uint64_t migrated_in = 0;
+    uint64_t migrated_out = 0;
+    uint64_t ghosts_received = 0;
+    uint64_t checksum = 0;
+    double frame_ms = 0.0;
+    int32_t status = -1;         // 0 = finished cleanly
+};
+
+class SharedRegion {
+public:
+    // Creates and maps the region. Mappings are inherited across fork(),
+    // and other processes may shm_open `name` while it exists.
+    SharedRegion(const std::string& name, size_t shard_count, uint64_t capacity)
+        : name(name), shard_count(shard_count), capacity(capacity) {
+        size = ChannelOffset(ChannelCount());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) throw std::runtime_error("shm_open failed for " + name);
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("ftruncate failed for " + name);
+        }
+        base = static_cast<uint8_t*>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        close(fd);
+        if (base == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            throw std::runtime_error("mmap failed for " + name);
+        }
+        
+        for (size_t s = 0; s < shard_count; ++s) new (&Report(s)) ShardReport();
+        for (size_t c = 0; c < ChannelCount(); ++c) {
+            Channel* channel = new (base + ChannelOffset(c)) Channel();
+            channel->head.store(0);
+            channel->tail.store(0);
+            channel->capacity = capacity;
+        }
+    }
+    
+    ~SharedRegion() {
+        munmap(base, size);
+        Unlink();
+    }
+    
+    SharedRegion(const SharedRegion&) = delete;
+    SharedRegion& operator=(const SharedRegion&) = delete;
+    
+    // The name can go once every process has the mapping
+    void Unlink() {
+        if (linked) shm_unlink(name.c_str());
+        linked = false;
+    }
+    
+    ShardReport& Report(size_t shard) {
+        return reinterpret_cast<ShardReport*>(base)[shard];
+    }
+    
+    // Ring carrying records from shard `from` to its neighbour on one side
+    Channel* ToLeft(size_t from) { return from > 0 ? ChannelAt(2 * (from - 1) + 1) : nullptr; }
+    Channel* ToRight(size_t from) { return from + 1 < shard_count ? ChannelAt(2 * from) : nullptr; }
+    Channel* FromLeft(size_t to) { return to > 0 ? ToRight(to - 1) : nullptr; }
+    Channel* FromRight(size_t to) { return to + 1 < shard_count ? ToLeft(to + 1) : nullptr; }
+
+private:
+    std::string name;
+    size_t shard_count;
+    uint64_t capacity;
+    size_t size = 0;
+    uint8_t* base = nullptr;
+    bool linked = true;
+    
+    size_t ChannelCount() const { return 2 * (shard_count - 1); }
+    
+    size_t ChannelOffset(size_t channel) const {
+        const size_t reports = (shard_count * sizeof(ShardReport) + 63) / 64 * 64;
+        return reports + channel * Channel::Bytes(capacity);
+    }
+    
+    Channel* ChannelAt(size_t channel) { return reinterpret_cast<Channel*>(base + ChannelOffset(channel)); }
+};
+
+// ============================================================================
+// SHARD - One strip's GameState and its half of the exchange
+// Rows [0, owned) are this shard's entities; rows after them are ghosts,
+// rebuilt every frame. Systems run over both, and whatever they do to the
+// ghosts is thrown away at the next exchange.
+// ============================================================================
+
+class Shard {
+public:
+    Shard(GameState& state, const Layout& layout, size_t index, SharedRegion& region)
+        : state(state), layout(layout), index(index),
+          to_left(region.ToLeft(index)), to_right(region.ToRight(index)),
+          from_left(region.FromLeft(index)), from_right(region.FromRight(index)) {}
+    
+    // Start from the whole world and keep this strip's entities; every
+    // shard does the same, so each entity ends up owned exactly once
+    void Claim() {
+        global_ids.resize(state.entity_count);
+        for (size_t i = 0; i < global_ids.size(); ++i) global_ids[i] = static_cast<uint32_t>(i);
+        owned = state.entity_count;
+        ids_before = global_ids;
+        Compact([this](EntityID i) { return layout.OwnerOf(state.transforms.position_x[i]) == index; });
+        RemapRows();
+    }
+    
+    // Between frames: hand over migrants, publish ghosts, take in the
+    // neighbours'. `frame` tags the batch so both sides stay in lockstep.
+    void Exchange(uint32_t frame) {
+        ids_before = global_ids;
+        RemoveGhosts();
+        
+        // Migrants, ascending, to whichever side they left by
+        Record record;
+        Compact([this, &record](EntityID i) {
+            const size_t owner = layout.OwnerOf(state.transforms.position_x[i]);
+            if (owner == index) return true;
+            Pack(state, i, global_ids[i], RecordKind::MIGRANT, record);
+            (owner < index ? to_left : to_right)->Push(record);
+            stats.migrated_out++;
+            return false;
+        });
+        
+        // Ghosts: owned entities close enough to a border to be seen across it
+        const float min_x = layout.MinX(index);
+        const float max_x = layout.MaxX(index);
+        for (EntityID i = 0; i < owned; ++i) {
+            const float x = state.transforms.position_x[i];
+            if (to_left && x < min_x + layout.ghost_range) {
+                Pack(state, i, global_ids[i], RecordKind::GHOST, record);
+                to_left->Push(record);
+            }
+            if (to_right && x >= max_x - layout.ghost_range) {
+                Pack(state, i, global_ids[i], RecordKind::GHOST, record);
+                to_right->Push(record);
+            }
+        }
+        record.kind = RecordKind::END_OF_FRAME;
+        record.global_id = frame;
+        if (to_left) to_left->Push(record);
+        if (to_right) to_right->Push(record);
+        
+        // Left neighbour first, then right: a fixed order for the handoff
+        incoming_migrants.clear();
+        incoming_ghosts.clear();
+        Receive(from_left, frame);
+        Receive(from_right, frame);
+        
+        const size_t first_migrant = owned;
+        owned += incoming_migrants.size();
+        state.Resize(owned + incoming_ghosts.size());
+        global_ids.resize(state.entity_count);
+        for (size_t k = 0; k < incoming_migrants.size(); ++k) {
+            const EntityID i = static_cast<EntityID>(first_migrant + k);
+            Unpack(incoming_migrants[k], state, i);
+            global_ids[i] = incoming_migrants[k].global_id;
+        }
+        for (size_t k = 0; k < incoming_ghosts.size(); ++k) {
+            const EntityID i = static_cast<EntityID>(owned + k);
+            Unpack(incoming_ghosts[k], state, i);
+            global_ids[i] = incoming_ghosts[k].global_id;
+        }
+        stats.migrated_in += incoming_migrants.size();
+        stats.ghosts_received += incoming_ghosts.size();
+        RemapRows();
+    }
+    
+    // Back to owned entities only (end of the run)
+    void DropGhosts() {
+        if (state.entity_count == owned) return;
+        ids_before = global_ids;
+        RemoveGhosts();
+        RemapRows();
+    }
+    
+    size_t Owned() const { return owned; }
+    const std::vector<uint32_t>& GlobalIds() const { return global_ids; }
+    
+    struct Stats {
+        uint64_t migrated_in = 0;
+        uint64_t migrated_out = 0;
+        uint64_t ghosts_received = 0;
+    };
+    const Stats& GetStats() const { return stats; }
+
+private:
+    GameState& state;
+    Layout layout;
+    size_t index;
+    Channel* to_left;
+    Channel* to_right;
+    Channel* from_left;
+    Channel* from_right;
+    size_t owned = 0;
+    std::vector<uint32_t> global_ids; // Per row
+    std::vector<Record> incoming_migrants;
+    std::vector<Record> incoming_ghosts;
+    std::vector<int32_t> new_index;   // Compaction map, -1 = gone
+    std::vector<uint32_t> ids_before; // Global id per row before this renumbering
+    std::vector<EntityID> row_of;     // Global id -> current row, INVALID_ENTITY = not here
+    Stats stats;
+    
+    void RemoveGhosts() {
+        if (state.entity_count == owned) return;
+        RemapPathRequests(nullptr);
+        state.Resize(owned);
+        global_ids.resize(owned);
+    }
+    
+    void Receive(Channel* channel, uint32_t frame) {
+        if (!channel) return;
+        while (true) {
+            Record record = channel->Pop();
+            if (record.kind == RecordKind::END_OF_FRAME) {
+                if (record.global_id != frame) throw std::runtime_error("Shard exchange out of step");
+                return;
+            }
+            (record.kind == RecordKind::MIGRANT ? incoming_migrants : incoming_ghosts).push_back(record);
+        }
+    }
+    
+    // Stable in-place removal of the owned rows `keep` rejects
+    template <typename Keep>
+    void Compact(Keep&& keep) {
+        new_index.assign(state.entity_count, -1);
+        size_t kept = 0;
+        for (EntityID i = 0; i < owned; ++i) {
+            if (!keep(i)) continue;
+            if (kept != i) {
+                state.CopyEntity(i, static_cast<EntityID>(kept));
+                global_ids[kept] = global_ids[i];
+                // The sets move along, still in old row numbers until RemapRows()
+                std::swap(state.stimulus_buffer.visible_entities[kept], state.stimulus_buffer.visible_entities[i]);
+                std::swap(state.stimulus_buffer.previous_visible[kept], state.stimulus_buffer.previous_visible[i]);
+            }
+            new_index[i] = static_cast<int32_t>(kept++);
+        }
+        if (kept == owned) return;
+        RemapPathRequests(&new_index);
+        owned = kept;
+        state.Resize(owned);
+        global_ids.resize(owned);
+    }
+    
+    // Visible sets and action targets name rows, and rows were renumbered
+    // since ids_before was taken. Translate each through its global id;
+    // entities no longer here (migrated away, ghost not resent) drop out.
+    // Observers that are not re-perceived this frame keep valid sets.
+    void RemapRows() {
+        uint32_t max_id = 0;
+        for (uint32_t id : ids_before) max_id = std::max(max_id, id);
+        for (uint32_t id : global_ids) max_id = std::max(max_id, id);
+        row_of.assign(static_cast<size_t>(max_id) + 1, INVALID_ENTITY);
+        for (size_t row = 0; row < global_ids.size(); ++row) row_of[global_ids[row]] = static_cast<EntityID>(row);
+        auto translate = [this](EntityID old_row) {
+            return old_row < ids_before.size() ? row_of[ids_before[old_row]] : INVALID_ENTITY;
+        };
+        auto remap_set = [&translate](std::vector<EntityID>& set) {
+            size_t out = 0;
+            for (EntityID old_row : set) {
+                const EntityID row = translate(old_row);
+                if (row != INVALID_ENTITY) set[out++] = row;
+            }
+            set.resize(out);
+            std::sort(set.begin(), set.end()); // Ghost rows come back in a new order
+        };
+        
+        GameState::StimulusBuffer& buffer = state.stimulus_buffer;
+        for (EntityID i = 0; i < state.entity_count; ++i) {
+            remap_set(buffer.visible_entities[i]);
+            remap_set(buffer.previous_visible[i]);
+            state.perception.visible_entity_count[i] = static_cast<uint32_t>(buffer.visible_entities[i].size());
+        }
+        auto remap_targets = [&](ActionComponents& actions) {
+            for (EntityID i = 0; i < state.entity_count; ++i) {
+                if (actions.target_entity[i] != INVALID_ENTITY) actions.target_entity[i] = translate(actions.target_entity[i]);
+            }
+        };
+        remap_targets(state.actions);
+        if (state.double_buffered & Component::ACTIONS) remap_targets(state.next_actions);
+    }
+    
+    // Queued pathfinding requests name rows; keep the ones whose entity
+    // survives (renumbered), in queue order. Without a map, rows past
+    // `owned` (ghosts) are the ones going away.
+    void RemapPathRequests(const std::vector<int32_t>* map) {
+        GameState::PathfindingService& service = state.pathfinding;
+        size_t out = 0;
+        for (size_t k = service.queue_head; k < service.queue.size(); ++k) {
+            GameState::PathfindingService::Request request = service.queue[k];
+            const int32_t row = map ? (*map)[request.entity]
+                                    : (request.entity < owned ? static_cast<int32_t>(request.entity) : -1);
+            if (row < 0) continue;
+            request.entity = static_cast<EntityID>(row);
+            service.queue[out++] = request;
+        }
+        service.queue.resize(out);
+        service.queue_head = 0;
+    }
+};
+
+} // namespace Sharding
@@ -1,23 +1,221 @@
 #pragma once
 
 #include "Components.h"
+#include "Determinism.h"
+#include "FastMath.h"
+#include "Parallel.h"
+#include "Pathfinding.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <cstring>
+#include <queue>
+#include <functional>
+#include <utility>
+#include <chrono>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 // ============================================================================
 // SYSTEM DECLARATIONS
 // All systems are stateless functions that transform data
+//
+// Each system picks its math accuracy at compile time with `using Math =
+// FastMath::Exact` or `FastMath::Fast` (see FastMath.h for error bounds).
+//
+// Each system declares the components it READS and WRITES, plus CROSS_READS:
+// components it reads for entities other than the one being updated. Systems
+// that can work on any sub-range of entities also expose UpdateRange().
 // ============================================================================
 
 namespace Systems {
 
+// ============================================================================
+// TARGET SCORING - Pluggable policies for choosing among visible entities
+// Lower score wins. Policies see the candidate and its squared distance.
+// ============================================================================
+struct NearestScore {
+    static float Score(const GameState& state, EntityID candidate, float distance_sq) {
+        (void)state; (void)candidate;
+        return distance_sq;
+    }
+};
+
+struct WeakestScore {
+    // Health dominates; distance only breaks ties between equally hurt prey
+    static float Score(const GameState& state, EntityID candidate, float distance_sq) {
+        return state.health.health[candidate] * 1.0e4f + distance_sq;
+    }
+};
+
+struct LightestArmorScore {
+    // Lower armor_type is easier prey; distance breaks ties
+    static float Score(const GameState& state, EntityID candidate, float distance_sq) {
+        return static_cast<float>(state.health.armor_type[candidate]) * 1.0e6f + distance_sq;
+    }
+};
+
+// ============================================================================
+// TIME SLICING - Rotating stripes for systems that need not run every frame
+// The population is cut into `slices` contiguous stripes and stripe k runs on
+// frames where frame % slices == k. An entity that has gone `slices` frames
+// without an update is forced through, so staleness stays bounded by the
+// slice count even when it is changed at runtime.
+// ============================================================================
+struct TimeSlicing {
+    static uint32_t StripeOf(EntityID id, size_t count, uint32_t slices) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(id) * slices) / count);
+    }
+    
+    static bool IsDue(const GameState& state, EntityID id, uint32_t last_update, uint32_t slices) {
+        if (slices <= 1) return true;
+        return state.frame_index % slices == StripeOf(id, state.entity_count, slices) ||
+               state.frame_index - last_update >= slices;
+    }
+    
+    // A last-update frame that makes the entity due at the next check,
+    // whatever its stripe, tier or slice count
+    static uint32_t Overdue(const GameState& state) {
+        return state.frame_index - UINT32_MAX / 2;
+    }
+    
+    // Frames between updates for the entity's LOD tier (1 at full detail)
+    static uint32_t TierPeriod(const GameState& state, EntityID id) {
+        return state.lod_config.tier_period[state.lod.tier[id]];
+    }
+};
+
+// ============================================================================
+// NEEDS MODEL - Closed-form need evolution
+// Each need moves linearly and then clamps, so k frames with the same action
+// and crowding collapse into one step that matches k per-frame steps (up to
+// float rounding). Curiosity is a clamped random walk, so it replays the k
+// counter-based per-frame draws, clamping after each as the eager path does.
+//
+// Contract: an entity's needs must be resolved up to the previous frame
+// before anything changes its inputs (current_action, or danger_level).
+// Influence and Utility do this for entities they touch.
+// ============================================================================
+struct NeedsModel {
+    static constexpr float HUNGER_RATE = 0.01f;
+    static constexpr float EAT_RATE = 0.15f;
+    static constexpr float SLEEP_RECOVERY = 0.1f;
+    static constexpr float ENERGY_DRAIN = 0.02f;
+    static constexpr float SAFETY_LOSS = 0.05f;
+    static constexpr float SAFETY_GAIN = 0.03f;
+    static constexpr int DANGER_LEVELS = 8; // Danger is held constant between levels
+    
+    static uint8_t DangerLevel(float danger) {
+        return static_cast<uint8_t>(danger * DANGER_LEVELS + 0.5f);
+    }
+    
+    // Apply `frames` per-frame steps of length delta_time in one go
+    static void Advance(GameState& state, EntityID i, uint32_t frames, float delta_time) {
+        const float k = static_cast<float>(frames);
+        const ActionType action = state.actions.current_action[i];
+        
+        // Hunger increases over time; eating outpaces it and bottoms out at 0.
+        // The per-frame order is grow-then-clamp-then-eat, hence the first frame
+        // being applied separately in the eating case.
+        const float hunger_step = HUNGER_RATE * delta_time;
+        if (action == ActionType::EAT) {
+            const float eat_step = EAT_RATE * delta_time;
+            float first = std::min(1.0f, state.needs.hunger[i] + hunger_step) - eat_step;
+            state.needs.hunger[i] = std::max(0.0f, first - (k - 1.0f) * (eat_step - hunger_step));
+        } else {
+            state.needs.hunger[i] = std::min(1.0f, state.needs.hunger[i] + k * (hunger_step));
+        }
+        
+        // Energy decreases when active, increases when sleeping
+        if (action == ActionType::SLEEP) {
+            state.needs.energy[i] = std::min(1.0f, state.needs.energy[i] + k * (SLEEP_RECOVERY * delta_time));
+        } else {
+            state.needs.energy[i] = std::max(0.0f, state.needs.energy[i] - k * (ENERGY_DRAIN * delta_time));
+        }
+        
+        // Safety recovers when calm and drains in danger, blending linearly
+        // between the two rates with the sampled danger level
+        const float danger = static_cast<float>(state.needs.danger_level[i]) / DANGER_LEVELS;
+        const float safety_rate = SAFETY_GAIN - danger * (SAFETY_GAIN + SAFETY_LOSS);
+        if (safety_rate < 0.0f) {
+            state.needs.safety[i] = std::max(0.0f, state.needs.safety[i] + k * (safety_rate * delta_time));
+        } else {
+            state.needs.safety[i] = std::min(1.0f, state.needs.safety[i] + k * (safety_rate * delta_time));
+        }
+        
+        // Curiosity fluctuates
+        const uint32_t first_frame = state.needs.last_update_frame[i] + 1;
+        float curiosity = state.needs.curiosity[i];
+        for (uint32_t f = 0; f < frames; ++f) {
+            const int drift = static_cast<int>(Determinism::RandomBelow(state.random_seed, Determinism::CURIOSITY,
+                                                                        i, first_frame + f, 100)) - 50;
+            curiosity = std::max(0.0f, std::min(1.0f, curiosity + drift * 0.001f * delta_time));
+        }
+        state.needs.curiosity[i] = curiosity;
+    }
+    
+    // Bring an entity's needs up to date through `through_frame` (inclusive)
+    static void Resolve(GameState& state, EntityID i, uint32_t through_frame, float delta_time) {
+        const uint32_t frames = through_frame - state.needs.last_update_frame[i];
+        if (frames == 0 || frames > UINT32_MAX / 2) return; // Already current
+        
+        Advance(state, i, frames, delta_time);
+        state.needs.last_update_frame[i] = through_frame;
+    }
+};
+
+class TargetSelector {
+public:
+    // Scan an observer's visible set once and return the lowest-scoring entity.
+    // Scores are computed into a flat scratch buffer first so the scoring and
+    // the min-reduction run as straight loops the compiler can vectorize.
+    template <typename ScorePolicy>
+    static EntityID SelectBest(const GameState& state, EntityID observer) {
+        const std::vector<EntityID>& visible = state.stimulus_buffer.visible_entities[observer];
+        const size_t count = visible.size();
+        if (count == 0) return INVALID_ENTITY;
+        
+        thread_local std::vector<float> scores;
+        scores.resize(count);
+        
+        const float obs_x = state.transforms.position_x[observer];
+        const float obs_y = state.transforms.position_y[observer];
+        
+        for (size_t k = 0; k < count; ++k) {
+            EntityID candidate = visible[k];
+            float dx = state.transforms.position_x[candidate] - obs_x;
+            float dy = state.transforms.position_y[candidate] - obs_y;
+            scores[k] = ScorePolicy::Score(state, candidate, dx * dx + dy * dy);
+        }
+        
+        size_t best = 0;
+        for (size_t k = 1; k < count; ++k) {
+            best = scores[k] < scores[best] ? k : best;
+        }
+        return visible[best];
+    }
+};
+
 // ============================================================================
 // PERCEPTION SYSTEM - "The Eyes"
 // Calculates what each entity can see in a single batched pass
 // ============================================================================
 class PerceptionSystem {
 public:
+    using Math = FastMath::Fast;
+    
+    static constexpr ComponentMask READS = Component::TRANSFORMS | Component::PERCEPTION |
+        Component::HEALTH | Component::LOD;
+    static constexpr ComponentMask WRITES = Component::SPATIAL_GRID | Component::STIMULUS |
+        Component::PERCEPTION;
+    static constexpr ComponentMask CROSS_READS = Component::TRANSFORMS | Component::HEALTH |
+        Component::SPATIAL_GRID;
+    
     static void Update(GameState& state, float delta_time) {
+        (void)delta_time;
+        
         // Step 1: Build spatial partition
         state.spatial_grid.Clear();
         for (EntityID i = 0; i < state.entity_count; ++i) {
@@ -28,18 +226,36 @@ public:
             }
         }
         
-        // Step 2: Clear previous stimulus
-        state.stimulus_buffer.Clear();
+        // Step 2: For each entity due this frame, query spatial grid for visible
+        // entities. Observers outside the current stripe keep last frame's stimulus.
+        GameState::StimulusBuffer& buffer = state.stimulus_buffer;
+        const bool track_changes = buffer.build_visibility_events;
+        buffer.entered.clear();
+        buffer.exited.clear();
         
-        // Step 3: For each entity, query spatial grid for visible entities
+        const uint32_t slices = state.scheduling.perception_slices;
         for (EntityID observer = 0; observer < state.entity_count; ++observer) {
             if (!state.health.is_alive[observer]) continue;
+            const uint32_t period = slices * TimeSlicing::TierPeriod(state, observer);
+            if (!TimeSlicing::IsDue(state, observer, state.perception.last_perception_frame[observer], period)) continue;
+            
+            state.perception.last_perception_frame[observer] = state.frame_index;
+            if (track_changes) std::swap(buffer.visible_entities[observer], buffer.previous_visible[observer]);
+            buffer.visible_entities[observer].clear();
             
             float obs_x = state.transforms.position_x[observer];
             float obs_y = state.transforms.position_y[observer];
-            float obs_orientation = state.transforms.orientation[observer];
+            float heading_x = state.transforms.heading_x[observer];
+            float heading_y = state.transforms.heading_y[observer];
             float view_range = state.perception.view_range[observer];
-            float view_angle = state.perception.view_angle[observer];
+            
+            // FOV test without trig per target: the target is inside the cone
+            // when dot(heading, offset) >= |offset| * cos(view_angle / 2).
+            // Compared squared to avoid the sqrt; the sign of the cosine decides
+            // which side of the inequality the squaring keeps.
+            float cos_half = Math::Cos(state.perception.view_angle[observer] * 0.5f);
+            float cos_half_sq = cos_half * cos_half;
+            bool wide_fov = cos_half < 0.0f; // FOV wider than 180 degrees
             
             // Query nearby cells
             int grid_x = static_cast<int>(obs_x / GameState::SpatialGrid::CELL_SIZE);
@@ -71,22 +287,269 @@ public:
                         if (distance_sq > view_range * view_range) continue;
                         
                         // Angle check (is target in FOV?)
-                        float angle_to_target = std::atan2(dy_dist, dx_dist);
-                        float angle_diff = std::abs(angle_to_target - obs_orientation);
-                        
-                        // Normalize angle difference to [-PI, PI]
-                        while (angle_diff > M_PI) angle_diff -= 2.0f * M_PI;
-                        while (angle_diff < -M_PI) angle_diff += 2.0f * M_PI;
+                        float dot = dx_dist * heading_x + dy_dist * heading_y;
+                        bool in_cone = wide_fov
+                            ? (dot >= 0.0f || dot * dot <= distance_sq * cos_half_sq)
+                            : (dot >= 0.0f && dot * dot >= distance_sq * cos_half_sq);
                         
-                        if (std::abs(angle_diff) <= view_angle / 2.0f) {
+                        if (in_cone) {
                             state.stimulus_buffer.visible_entities[observer].push_back(target);
                         }
                     }
                 }
             }
             
-            state.perception.visible_entity_count[observer] = 
-                static_cast<uint32_t>(state.stimulus_buffer.visible_entities[observer].size());
+            std::vector<EntityID>& visible = buffer.visible_entities[observer];
+            std::sort(visible.begin(), visible.end());
+            if (track_changes) DiffVisibleSets(buffer, observer);
+            state.perception.visible_entity_count[observer] = static_cast<uint32_t>(visible.size());
+        }
+        
+        // Step 3: Transpose into the reverse index if anyone asked for it
+        if (state.stimulus_buffer.build_reverse_index) BuildReverseIndex(state);
+    }
+    
+    // One merge over the sorted previous and current sets: targets only in
+    // the current set entered view, targets only in the previous one left it
+    static void DiffVisibleSets(GameState::StimulusBuffer& buffer, EntityID observer) {
+        const std::vector<EntityID>& before = buffer.previous_visible[observer];
+        const std::vector<EntityID>& after = buffer.visible_entities[observer];
+        size_t b = 0;
+        size_t a = 0;
+        while (b < before.size() && a < after.size()) {
+            if (before[b] == after[a]) {
+                ++b;
+                ++a;
+            } else if (after[a] < before[b]) {
+                buffer.entered.push_back({observer, after[a++]});
+            } else {
+                buffer.exited.push_back({observer, before[b++]});
+            }
+        }
+        for (; a < after.size(); ++a) buffer.entered.push_back({observer, after[a]});
+        for (; b < before.size(); ++b) buffer.exited.push_back({observer, before[b]});
+    }
+    
+    // Parallel counting sort of every (observer, target) pair by target,
+    // with one counter per target: observers count their targets with
+    // atomic adds, a blocked scan (parallel over blocks of targets) turns
+    // the counts into write cursors, and the scatter claims slots through
+    // them. Slots within a target are claimed in any order, so each
+    // target's observers are sorted afterwards to come out ascending.
+    // Scratch is one counter per entity plus one offset per block.
+    static constexpr size_t REVERSE_INDEX_GRAIN = 1024; // Observers or targets per job
+    
+    static void BuildReverseIndex(GameState& state) {
+        GameState::StimulusBuffer& buffer = state.stimulus_buffer;
+        const size_t n = state.entity_count;
+        const size_t blocks = (n + REVERSE_INDEX_GRAIN - 1) / REVERSE_INDEX_GRAIN;
+        AtomicCounters& counts = buffer.observer_counts;
+        counts.Reserve(n);
+        
+        auto for_each_pair = [&state, n](size_t first, size_t last, auto&& visit) {
+            for (size_t observer = first; observer < last; ++observer) {
+                if (!state.health.is_alive[observer]) continue;
+                for (EntityID target : state.stimulus_buffer.visible_entities[observer]) {
+                    assert(target < n && "visible set holds a stale row index");
+                    visit(static_cast<EntityID>(observer), target);
+                }
+            }
+        };
+        
+        Parallel::For(0, n, REVERSE_INDEX_GRAIN, [&counts](size_t first, size_t last) {
+            for (size_t target = first; target < last; ++target) counts[target].store(0, std::memory_order_relaxed);
+        });
+        Parallel::For(0, n, REVERSE_INDEX_GRAIN, [&](size_t first, size_t last) {
+            for_each_pair(first, last, [&counts](EntityID, EntityID target) {
+                counts[target].fetch_add(1, std::memory_order_relaxed);
+            });
+        });
+        
+        // Exclusive scan: block totals in parallel, a short serial scan over
+        // the blocks, then each block writes its offsets and cursors
+        buffer.block_offsets.assign(blocks + 1, 0);
+        Parallel::For(0, blocks, 1, [&](size_t first, size_t last) {
+            for (size_t block = first; block < last; ++block) {
+                uint32_t total = 0;
+                const size_t end = std::min(n, (block + 1) * REVERSE_INDEX_GRAIN);
+                for (size_t target = block * REVERSE_INDEX_GRAIN; target < end; ++target) {
+                    total += counts[target].load(std::memory_order_relaxed);
+                }
+                buffer.block_offsets[block + 1] = total;
+            }
+        });
+        for (size_t block = 0; block < blocks; ++block) buffer.block_offsets[block + 1] += buffer.block_offsets[block];
+        
+        buffer.observer_offsets.resize(n + 1);
+        Parallel::For(0, blocks, 1, [&](size_t first, size_t last) {
+            for (size_t block = first; block < last; ++block) {
+                uint32_t running = buffer.block_offsets[block];
+                const size_t end = std::min(n, (block + 1) * REVERSE_INDEX_GRAIN);
+                for (size_t target = block * REVERSE_INDEX_GRAIN; target < end; ++target) {
+                    const uint32_t count = counts[target].load(std::memory_order_relaxed);
+                    buffer.observer_offsets[target] = running;
+                    counts[target].store(running, std::memory_order_relaxed);
+                    running += count;
+                }
+            }
+        });
+        buffer.observer_offsets[n] = buffer.block_offsets[blocks];
+        buffer.observers.resize(buffer.block_offsets[blocks]);
+        
+        EntityID* out = buffer.observers.data();
+        Parallel::For(0, n, REVERSE_INDEX_GRAIN, [&](size_t first, size_t last) {
+            for_each_pair(first, last, [&counts, out](EntityID observer, EntityID target) {
+                out[counts[target].fetch_add(1, std::memory_order_relaxed)] = observer;
+            });
+        });
+        Parallel::For(0, n, REVERSE_INDEX_GRAIN, [&buffer, out](size_t first, size_t last) {
+            for (size_t target = first; target < last; ++target) {
+                std::sort(out + buffer.observer_offsets[target], out + buffer.observer_offsets[target + 1]);
+            }
+        });
+    }
+};
+
+// ============================================================================
+// LOD SYSTEM - "The Attention"
+// Assigns each entity a detail tier from its grid cell's distance to the
+// nearest region of interest. Runs after perception so the grid is current.
+// ============================================================================
+class LODSystem {
+public:
+    using Math = FastMath::Fast;
+    
+    static constexpr ComponentMask READS = Component::SPATIAL_GRID | Component::LOD;
+    static constexpr ComponentMask WRITES = Component::LOD;
+    static constexpr ComponentMask CROSS_READS = Component::SPATIAL_GRID;
+    
+    static void Update(GameState& state, float delta_time) {
+        (void)delta_time;
+        using Grid = GameState::SpatialGrid;
+        const GameState::LODConfig& config = state.lod_config;
+        
+        if (state.regions_of_interest.empty()) {
+            std::fill(state.lod.tier.begin(), state.lod.tier.end(), 0);
+            return;
+        }
+        
+        for (int cx = 0; cx < Grid::GRID_SIZE; ++cx) {
+            for (int cy = 0; cy < Grid::GRID_SIZE; ++cy) {
+                const std::vector<EntityID>& cell = state.spatial_grid.cells[cx][cy];
+                if (cell.empty()) continue;
+                
+                // Distance from the cell centre to the edge of the nearest region
+                float center_x = (cx + 0.5f) * Grid::CELL_SIZE;
+                float center_y = (cy + 0.5f) * Grid::CELL_SIZE;
+                float distance = std::numeric_limits<float>::max();
+                for (const GameState::RegionOfInterest& roi : state.regions_of_interest) {
+                    float dx = center_x - roi.x;
+                    float dy = center_y - roi.y;
+                    distance = std::min(distance, Math::Sqrt(dx * dx + dy * dy) - roi.radius);
+                }
+                
+                for (EntityID id : cell) {
+                    state.lod.tier[id] = TierFor(config, distance, state.lod.tier[id]);
+                }
+            }
+        }
+    }
+    
+    // Promote as soon as an entity is inside a band; demote only once it is
+    // `hysteresis` past the band edge so border entities do not flicker.
+    static uint8_t TierFor(const GameState::LODConfig& config, float distance, uint8_t current) {
+        uint8_t tier = 0;
+        while (tier < GameState::LODConfig::TIER_COUNT - 1) {
+            float limit = config.tier_distance[tier];
+            if (tier < current) limit += config.hysteresis;
+            if (distance <= limit) break;
+            ++tier;
+        }
+        return tier;
+    }
+};
+
+// ============================================================================
+// INFLUENCE SYSTEM - "The Sense of Danger"
+// Rasterizes crowd density and threat (attacking entities) into the
+// influence map in one pass over the spatial grid, blurs it, and gives every
+// entity its danger level with a single lookup. Coarse LOD tiers, which
+// perceive rarely, still feel danger every frame.
+// ============================================================================
+class InfluenceSystem {
+public:
+    using Map = GameState::InfluenceMap;
+    
+    static constexpr int BLUR_PASSES = 2; // Each [1 2 1] pass widens the kernel by one cell
+    
+    static constexpr ComponentMask READS = Component::SPATIAL_GRID | Component::ACTIONS |
+        Component::HEALTH | Component::TRANSFORMS | Component::NEEDS | Component::INFLUENCE;
+    static constexpr ComponentMask WRITES = Component::INFLUENCE | Component::NEEDS;
+    static constexpr ComponentMask CROSS_READS = Component::SPATIAL_GRID | Component::ACTIONS |
+        Component::HEALTH;
+    
+    static void Update(GameState& state, float delta_time) {
+        using Grid = GameState::SpatialGrid;
+        Map& map = state.influence;
+        
+        // Rasterize: the border ring is never written and stays zero
+        for (int cx = 0; cx < Grid::GRID_SIZE; ++cx) {
+            for (int cy = 0; cy < Grid::GRID_SIZE; ++cy) {
+                float density = 0.0f;
+                float threat = 0.0f;
+                for (EntityID id : state.spatial_grid.cells[cx][cy]) {
+                    if (!state.health.is_alive[id]) continue;
+                    density += 1.0f;
+                    threat += state.actions.current_action[id] == ActionType::ATTACK ? 1.0f : 0.0f;
+                }
+                map.density[Map::Index(cx, cy)] = density;
+                map.threat[Map::Index(cx, cy)] = threat;
+            }
+        }
+        
+        for (int pass = 0; pass < BLUR_PASSES; ++pass) {
+            Blur(map.density, map.scratch);
+            Blur(map.threat, map.scratch);
+        }
+        
+        const size_t cells = map.danger.size();
+        for (size_t i = 0; i < cells; ++i) {
+            map.danger[i] = Map::DENSITY_WEIGHT * map.density[i] + Map::THREAT_WEIGHT * map.threat[i];
+        }
+        
+        // Sample: lazily-updated needs are settled under the old level first
+        for (EntityID i = 0; i < state.entity_count; ++i) {
+            if (!state.health.is_alive[i]) continue;
+            uint8_t level = NeedsModel::DangerLevel(
+                map.SampleDanger(state.transforms.position_x[i], state.transforms.position_y[i]));
+            if (level != state.needs.danger_level[i]) {
+                NeedsModel::Resolve(state, i, state.frame_index - 1, delta_time);
+                state.needs.danger_level[i] = level;
+            }
+        }
+    }
+    
+    // Separable [1 2 1] / 4 blur over the interior. Both passes walk
+    // contiguous rows with no branches, so they vectorize.
+    static void Blur(std::vector<float>& field, std::vector<float>& scratch) {
+        constexpr int N = GameState::SpatialGrid::GRID_SIZE;
+        float* values = field.data();
+        float* temp = scratch.data();
+        for (int x = 1; x <= N; ++x) {
+            const float* row = values + x * Map::STRIDE;
+            float* out = temp + x * Map::STRIDE;
+            for (int y = 1; y <= N; ++y) {
+                out[y] = 0.5f * row[y] + 0.25f * (row[y - 1] + row[y + 1]);
+            }
+        }
+        for (int x = 1; x <= N; ++x) {
+            const float* above = temp + (x - 1) * Map::STRIDE;
+            const float* row = temp + x * Map::STRIDE;
+            const float* below = temp + (x + 1) * Map::STRIDE;
+            float* out = values + x * Map::STRIDE;
+            for (int y = 1; y <= N; ++y) {
+                out[y] = 0.5f * row[y] + 0.25f * (above[y] + below[y]);
+            }
         }
     }
 };
@@ -97,10 +560,15 @@ public:
 // ============================================================================
 class UtilitySystem {
 public:
+    using Math = FastMath::Fast;
+    
     // Response curves for utility calculations
     static float LinearCurve(float x) { return x; }
     static float QuadraticCurve(float x) { return x * x; }
     static float InverseLinearCurve(float x) { return 1.0f - x; }
+    static float LogisticCurve(float x, float steepness = 10.0f, float midpoint = 0.5f) {
+        return 1.0f / (1.0f + Math::Exp(-steepness * (x - midpoint)));
+    }
     
     // Calculate utility for each action type
     static float CalculateEatUtility(const GameState& state, EntityID id) {
@@ -131,10 +599,41 @@ public:
         return state.needs.hunger[id] * state.needs.energy[id] * 0.8f;
     }
     
+    static constexpr ComponentMask READS = Component::NEEDS | Component::STIMULUS |
+        Component::TRANSFORMS | Component::HEALTH | Component::LOD | Component::ACTIONS |
+        Component::PERCEPTION | Component::INFLUENCE;
+    static constexpr ComponentMask WRITES = Component::ACTIONS | Component::NEEDS;
+    static constexpr ComponentMask CROSS_READS = Component::TRANSFORMS | Component::HEALTH;
+    
+    // PreyScore picks the ATTACK target. FLEE runs down the influence map's
+    // danger gradient, or from the nearest visible entity where the map is
+    // flat. The chosen entity and the point to move toward (or away from) are
+    // cached in ActionComponents so the KineticSystem never has to look at
+    // the stimulus buffer.
+    template <typename PreyScore = NearestScore>
     static void Update(GameState& state, float delta_time) {
-        // For each entity, calculate utility for all actions and pick best
-        for (EntityID i = 0; i < state.entity_count; ++i) {
+        UpdateRange<PreyScore>(state, 0, static_cast<EntityID>(state.entity_count), delta_time);
+    }
+    
+    template <typename PreyScore = NearestScore>
+    static void UpdateRange(GameState& state, EntityID begin, EntityID end, float delta_time) {
+        // Double-buffered: decisions for frame N + 1 start from frame N's
+        ActionComponents& actions = state.WrittenActions();
+        if (state.double_buffered & Component::ACTIONS) {
+            actions.CopyRows(state.actions, begin, end);
+        }
+        
+        // For each entity due this frame, calculate utility for all actions and pick best
+        const uint32_t slices = state.scheduling.utility_slices;
+        for (EntityID i = begin; i < end; ++i) {
             if (!state.health.is_alive[i]) continue;
+            const uint32_t period = slices * TimeSlicing::TierPeriod(state, i);
+            if (!TimeSlicing::IsDue(state, i, actions.last_decision_frame[i], period)) continue;
+            
+            actions.last_decision_frame[i] = state.frame_index;
+            
+            // Needs may be lagging (sleeping / LOD-demoted); settle them before reading
+            NeedsModel::Resolve(state, i, state.frame_index - 1, delta_time);
             
             // Calculate utilities
             float eat_utility = CalculateEatUtility(state, i);
@@ -169,20 +668,509 @@ public:
             }
             
             // Write decision
-            state.actions.current_action[i] = best_action;
-            state.actions.action_utility[i] = max_utility;
-            
-            // Set target based on action
-            if (best_action == ActionType::ATTACK && !state.stimulus_buffer.visible_entities[i].empty()) {
-                EntityID target = state.stimulus_buffer.visible_entities[i][0];
-                state.actions.target_entity[i] = target;
-                state.actions.target_x[i] = state.transforms.position_x[target];
-                state.actions.target_y[i] = state.transforms.position_y[target];
+            actions.current_action[i] = best_action;
+            actions.action_utility[i] = max_utility;
+            
+            // Set target based on action. Fleeing reads the danger gradient in
+            // O(1) and scans the visible set only where the map is flat.
+            EntityID target = INVALID_ENTITY;
+            float flee_x = 0.0f;
+            float flee_y = 0.0f;
+            if (best_action == ActionType::ATTACK) {
+                target = TargetSelector::SelectBest<PreyScore>(state, i);
+            } else if (best_action == ActionType::FLEE) {
+                state.influence.FleeDirection(state.transforms.position_x[i], state.transforms.position_y[i],
+                                              flee_x, flee_y);
+                if (flee_x == 0.0f && flee_y == 0.0f) {
+                    target = TargetSelector::SelectBest<NearestScore>(state, i);
+                }
+            }
+            actions.target_entity[i] = target;
+            
+            if (flee_x != 0.0f || flee_y != 0.0f) {
+                // Flee from a point one cell uphill
+                const float reach = GameState::SpatialGrid::CELL_SIZE;
+                actions.target_x[i] = state.transforms.position_x[i] - flee_x * reach;
+                actions.target_y[i] = state.transforms.position_y[i] - flee_y * reach;
+            } else if (target != INVALID_ENTITY) {
+                actions.target_x[i] = state.transforms.position_x[target];
+                actions.target_y[i] = state.transforms.position_y[target];
+            } else if (best_action == ActionType::FLEE) {
+                // Nothing to run from: a zero flee vector holds the entity still
+                actions.target_x[i] = state.transforms.position_x[i];
+                actions.target_y[i] = state.transforms.position_y[i];
             } else if (best_action == ActionType::EXPLORE) {
                 // Random exploration target
-                state.actions.target_x[i] = state.transforms.position_x[i] + (rand() % 20 - 10);
-                state.actions.target_y[i] = state.transforms.position_y[i] + (rand() % 20 - 10);
+                using Determinism::RandomBelow;
+                const int dx = static_cast<int>(RandomBelow(state.random_seed, Determinism::EXPLORE_X,
+                                                            i, state.frame_index, 20)) - 10;
+                const int dy = static_cast<int>(RandomBelow(state.random_seed, Determinism::EXPLORE_Y,
+                                                            i, state.frame_index, 20)) - 10;
+                actions.target_x[i] = state.transforms.position_x[i] + dx;
+                actions.target_y[i] = state.transforms.position_y[i] + dy;
+            }
+        }
+    }
+};
+
+// ============================================================================
+// SEPARATION SYSTEM - "The Personal Space"
+// Pushes agents apart using this frame's SpatialGrid as the broadphase. Work
+// is batched per cell: the 3x3 neighbourhood's positions are gathered into
+// contiguous arrays once, then every agent in the centre cell sweeps them in
+// a straight loop. Each cell only writes its own agents, so grid columns run
+// in parallel without synchronization. Cost is linear in local density.
+// ============================================================================
+class SeparationSystem {
+public:
+    using Math = FastMath::Fast;
+    
+    static constexpr float RADIUS = 2.0f; // Must not exceed the grid cell size
+    static_assert(RADIUS <= GameState::SpatialGrid::CELL_SIZE, "Separation radius exceeds the 3x3 query");
+    static constexpr size_t COLUMNS_PER_TASK = 4;
+    
+    static constexpr ComponentMask READS = Component::SPATIAL_GRID | Component::TRANSFORMS;
+    static constexpr ComponentMask WRITES = Component::STEERING;
+    static constexpr ComponentMask CROSS_READS = Component::SPATIAL_GRID | Component::TRANSFORMS;
+    
+    static void Update(GameState& state, float delta_time) {
+        (void)delta_time;
+        Parallel::For(0, GameState::SpatialGrid::GRID_SIZE, COLUMNS_PER_TASK,
+            [&state](size_t column_begin, size_t column_end) {
+                for (size_t cx = column_begin; cx < column_end; ++cx) {
+                    for (int cy = 0; cy < GameState::SpatialGrid::GRID_SIZE; ++cy) {
+                        UpdateCell(state, static_cast<int>(cx), cy);
+                    }
+                }
+            });
+    }
+    
+private:
+    static void UpdateCell(GameState& state, int cx, int cy) {
+        using Grid = GameState::SpatialGrid;
+        const std::vector<EntityID>& cell = state.spatial_grid.cells[cx][cy];
+        if (cell.empty()) return;
+        
+        // Gather the neighbourhood (centre cell included) once for the whole cell
+        thread_local std::vector<float> neighbor_x;
+        thread_local std::vector<float> neighbor_y;
+        neighbor_x.clear();
+        neighbor_y.clear();
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                int nx = cx + dx;
+                int ny = cy + dy;
+                if (nx < 0 || nx >= Grid::GRID_SIZE || ny < 0 || ny >= Grid::GRID_SIZE) continue;
+                for (EntityID neighbor : state.spatial_grid.cells[nx][ny]) {
+                    neighbor_x.push_back(state.transforms.position_x[neighbor]);
+                    neighbor_y.push_back(state.transforms.position_y[neighbor]);
+                }
+            }
+        }
+        
+        const size_t neighbor_count = neighbor_x.size();
+        const float* px = neighbor_x.data();
+        const float* py = neighbor_y.data();
+        const float radius_sq = RADIUS * RADIUS;
+        
+        for (EntityID id : cell) {
+            const float x = state.transforms.position_x[id];
+            const float y = state.transforms.position_y[id];
+            float push_x = 0.0f;
+            float push_y = 0.0f;
+            
+            // Linear falloff: full push when touching, none at RADIUS. The agent
+            // itself (distance 0) and exact overlaps contribute nothing.
+            for (size_t k = 0; k < neighbor_count; ++k) {
+                float ox = x - px[k];
+                float oy = y - py[k];
+                float distance_sq = ox * ox + oy * oy;
+                bool near = distance_sq < radius_sq && distance_sq > 0.0f;
+                float inv_distance = Math::Rsqrt(near ? distance_sq : 1.0f);
+                float weight = near ? (inv_distance - 1.0f / RADIUS) : 0.0f;
+                push_x += ox * weight;
+                push_y += oy * weight;
+            }
+            
+            state.steering.separation_x[id] = push_x;
+            state.steering.separation_y[id] = push_y;
+        }
+    }
+};
+
+// ============================================================================
+// FLOW FIELD SYSTEM - "The Shared Map"
+// Goal cells that enough MOVE_TO_TARGET / EXPLORE agents are heading to get
+// one Dijkstra integration field each, cached across frames. Every agent
+// then reads its steering direction with a single lookup at its own cell, so
+// navigation cost is paid per goal rather than per agent.
+// ============================================================================
+class FlowFieldSystem {
+public:
+    using Cache = GameState::FlowFieldCache;
+    
+    static constexpr uint16_t MIN_DEMAND = 8; // Agents needed before a goal gets a field
+    
+    // Unit vectors for Pathfinding::OFFSET_X/Y; a field's direction codes index these
+    static constexpr float DIRECTION_X[8] = {1.0f, 0.70710678f, 0.0f, -0.70710678f, -1.0f, -0.70710678f, 0.0f, 0.70710678f};
+    static constexpr float DIRECTION_Y[8] = {0.0f, 0.70710678f, 1.0f, 0.70710678f, 0.0f, -0.70710678f, -1.0f, -0.70710678f};
+    
+    static constexpr ComponentMask READS = Component::ACTIONS | Component::TRANSFORMS |
+        Component::HEALTH | Component::FLOW_FIELDS | Component::NAVIGATION;
+    static constexpr ComponentMask WRITES = Component::STEERING | Component::FLOW_FIELDS;
+    static constexpr ComponentMask CROSS_READS = Component::NONE;
+    
+    static void Update(GameState& state, float delta_time) {
+        (void)delta_time;
+        Cache& cache = state.flow_fields;
+        
+        // Count how many seekers share each goal cell
+        cache.demand.assign(Cache::CELL_COUNT, 0);
+        for (size_t i = 0; i < state.entity_count; ++i) {
+            if (!state.health.is_alive[i] || !UsesFlowField(state.actions.current_action[i])) continue;
+            uint16_t& demand = cache.demand[CellIndex(state.actions.target_x[i], state.actions.target_y[i])];
+            if (demand < UINT16_MAX) demand++;
+        }
+        
+        // The most requested goals, up to the cache size
+        std::vector<int> popular;
+        for (int cell = 0; cell < Cache::CELL_COUNT; ++cell) {
+            if (cache.demand[cell] >= MIN_DEMAND) popular.push_back(cell);
+        }
+        if (popular.size() > Cache::MAX_FIELDS) {
+            std::partial_sort(popular.begin(), popular.begin() + Cache::MAX_FIELDS, popular.end(),
+                [&cache](int a, int b) { return cache.demand[a] > cache.demand[b]; });
+            popular.resize(Cache::MAX_FIELDS);
+        }
+        
+        // Map goals to cached fields; missing or stale ones are rebuilt below
+        cache.slot_of_goal.assign(Cache::CELL_COUNT, -1);
+        std::vector<size_t> stale;
+        for (int goal : popular) {
+            size_t slot = FindOrEvict(cache, goal, state.frame_index);
+            Cache::Field& field = cache.fields[slot];
+            if (field.goal_cell != goal || field.version != state.obstacles.version) {
+                field.goal_cell = goal;
+                field.version = state.obstacles.version;
+                stale.push_back(slot);
+            } else {
+                cache.reuses++;
+            }
+            field.last_used_frame = state.frame_index;
+            cache.slot_of_goal[goal] = static_cast<int16_t>(slot);
+        }
+        
+        Parallel::For(0, stale.size(), 1, [&state, &cache, &stale](size_t first, size_t last) {
+            for (size_t k = first; k < last; ++k) BuildField(state.obstacles, cache.fields[stale[k]]);
+        });
+        cache.builds += stale.size();
+        
+        // Sample: one lookup per agent. Agents already in the goal cell, or
+        // without a field, steer straight at their target.
+        for (size_t i = 0; i < state.entity_count; ++i) {
+            float guide_x = 0.0f;
+            float guide_y = 0.0f;
+            if (state.health.is_alive[i] && UsesFlowField(state.actions.current_action[i])) {
+                int goal = CellIndex(state.actions.target_x[i], state.actions.target_y[i]);
+                int slot = cache.slot_of_goal[goal];
+                int cell = CellIndex(state.transforms.position_x[i], state.transforms.position_y[i]);
+                if (slot >= 0 && cell != goal) {
+                    uint8_t code = cache.fields[slot].direction[cell];
+                    if (code != Cache::NO_DIRECTION) {
+                        guide_x = DIRECTION_X[code];
+                        guide_y = DIRECTION_Y[code];
+                    }
+                }
+            }
+            state.steering.guide_x[i] = guide_x;
+            state.steering.guide_y[i] = guide_y;
+        }
+    }
+    
+    static bool UsesFlowField(ActionType action) {
+        return action == ActionType::MOVE_TO_TARGET || action == ActionType::EXPLORE;
+    }
+    
+    static int CellIndex(float x, float y) {
+        return GameState::SpatialGrid::CellIndex(x, y);
+    }
+    
+    // Wavefront from the goal over open 8-connected cells, then point every
+    // reachable cell at its cheapest neighbour. Moves are the reverse of
+    // CanStep's, which is symmetric, so following the field never cuts a corner.
+    static void BuildField(const GameState::ObstacleMap& obstacles, Cache::Field& field) {
+        using Pathfinding::OFFSET_X;
+        using Pathfinding::OFFSET_Y;
+        constexpr int N = GameState::SpatialGrid::GRID_SIZE;
+        field.integration.assign(Cache::CELL_COUNT, Cache::UNREACHABLE);
+        field.direction.assign(Cache::CELL_COUNT, Cache::NO_DIRECTION);
+        
+        using Entry = std::pair<uint32_t, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+        if (obstacles.IsBlocked(field.goal_cell / N, field.goal_cell % N)) return;
+        field.integration[field.goal_cell] = 0;
+        frontier.push({0, field.goal_cell});
+        
+        while (!frontier.empty()) {
+            auto [cost, cell] = frontier.top();
+            frontier.pop();
+            if (cost > field.integration[cell]) continue; // Superseded entry
+            
+            int cx = cell / N;
+            int cy = cell % N;
+            for (int d = 0; d < 8; ++d) {
+                if (!Pathfinding::CanStep(obstacles, cx, cy, d)) continue;
+                int next = (cx + OFFSET_X[d]) * N + (cy + OFFSET_Y[d]);
+                uint32_t next_cost = cost + ((d & 1) ? Pathfinding::DIAGONAL_COST : Pathfinding::STRAIGHT_COST);
+                if (next_cost < field.integration[next]) {
+                    field.integration[next] = next_cost;
+                    frontier.push({next_cost, next});
+                }
+            }
+        }
+        
+        for (int cell = 0; cell < Cache::CELL_COUNT; ++cell) {
+            int cx = cell / N;
+            int cy = cell % N;
+            uint32_t best = field.integration[cell];
+            if (best == Cache::UNREACHABLE) continue;
+            for (int d = 0; d < 8; ++d) {
+                if (!Pathfinding::CanStep(obstacles, cx, cy, d)) continue;
+                uint32_t cost = field.integration[(cx + OFFSET_X[d]) * N + (cy + OFFSET_Y[d])];
+                if (cost < best) {
+                    best = cost;
+                    field.direction[cell] = static_cast<uint8_t>(d);
+                }
+            }
+        }
+    }
+    
+private:
+    // The goal's cached slot, else a new slot, else the least recently used
+    // field not claimed this frame (there is always one: goals <= MAX_FIELDS)
+    static size_t FindOrEvict(Cache& cache, int goal, uint32_t frame) {
+        for (size_t slot = 0; slot < cache.fields.size(); ++slot) {
+            if (cache.fields[slot].goal_cell == goal) return slot;
+        }
+        if (cache.fields.size() < Cache::MAX_FIELDS) {
+            cache.fields.emplace_back();
+            return cache.fields.size() - 1;
+        }
+        size_t victim = 0;
+        for (size_t slot = 0; slot < cache.fields.size(); ++slot) {
+            const Cache::Field& field = cache.fields[slot];
+            if (field.last_used_frame == frame) continue;
+            if (cache.fields[victim].last_used_frame == frame ||
+                field.last_used_frame < cache.fields[victim].last_used_frame) {
+                victim = slot;
+            }
+        }
+        return victim;
+    }
+};
+
+// ============================================================================
+// PATH SYSTEM - "The Navigator"
+// Seekers whose target is hidden behind obstacles ask the pathfinding
+// service for a route. Requests are served in batches within a per-frame
+// time budget, so a burst of requests delays routes instead of the frame;
+// until its route arrives an agent steers straight at its target. Routes are
+// followed by writing the direction to the next waypoint into the steering
+// guide, after any flow field (which takes precedence) has been sampled.
+// ============================================================================
+class PathSystem {
+public:
+    using Service = GameState::PathfindingService;
+    
+    static constexpr size_t BATCH_SIZE = 32;
+    static constexpr float ARRIVAL_RADIUS = GameState::SpatialGrid::CELL_SIZE * 0.5f;
+    
+    static constexpr ComponentMask READS = Component::ACTIONS | Component::TRANSFORMS |
+        Component::HEALTH | Component::NAVIGATION | Component::PATHS | Component::STEERING;
+    static constexpr ComponentMask WRITES = Component::NAVIGATION | Component::PATHS | Component::STEERING;
+    static constexpr ComponentMask CROSS_READS = Component::NONE;
+    
+    static void Update(GameState& state, float delta_time) {
+        (void)delta_time;
+        if (state.pathfinding.graph.version != state.obstacles.version) RebuildNavigation(state);
+        
+        QueueRequests(state);
+        ServeRequests(state);
+        FollowPaths(state);
+    }
+    
+    static bool UsesPath(ActionType action) {
+        return action == ActionType::MOVE_TO_TARGET || action == ActionType::EXPLORE;
+    }
+    
+    // A changed obstacle map invalidates the graph, the cache and every route.
+    // Update does this lazily; call it up front after placing static obstacles
+    // so the first frame does not pay for the graph.
+    static void RebuildNavigation(GameState& state) {
+        Service& service = state.pathfinding;
+        Pathfinding::BuildGraph(state.obstacles, service.graph);
+        service.route_cache.clear();
+        service.queue.clear();
+        service.queue_head = 0;
+        std::fill(state.paths.status.begin(), state.paths.status.end(), PathStatus::NONE);
+        std::fill(state.paths.goal_cell.begin(), state.paths.goal_cell.end(), -1);
+    }
+    
+private:
+    // One request per new goal; targets in plain sight need none
+    static void QueueRequests(GameState& state) {
+        PathComponents& paths = state.paths;
+        for (EntityID i = 0; i < state.entity_count; ++i) {
+            const bool guided = state.steering.guide_x[i] != 0.0f || state.steering.guide_y[i] != 0.0f;
+            if (!state.health.is_alive[i] || !UsesPath(state.actions.current_action[i]) || guided) {
+                paths.status[i] = PathStatus::NONE;
+                paths.goal_cell[i] = -1;
+                continue;
+            }
+            
+            const float x = state.transforms.position_x[i];
+            const float y = state.transforms.position_y[i];
+            const float target_x = state.actions.target_x[i];
+            const float target_y = state.actions.target_y[i];
+            const int goal = GameState::SpatialGrid::CellIndex(target_x, target_y);
+            if (paths.status[i] != PathStatus::NONE && paths.goal_cell[i] == goal) continue;
+            
+            paths.goal_cell[i] = goal;
+            paths.cursor[i] = 0;
+            paths.waypoints[i].clear();
+            if (state.obstacles.blocked_count == 0 ||
+                Pathfinding::LineOfSight(state.obstacles, x, y, target_x, target_y)) {
+                paths.status[i] = PathStatus::DIRECT;
+            } else {
+                paths.status[i] = PathStatus::PENDING;
+                state.pathfinding.queue.push_back({i, GameState::SpatialGrid::CellIndex(x, y), goal});
+            }
+        }
+    }
+    
+    // Batches until the frame budget runs out, or frame_batch_limit batches
+    // when set (always at least one, so the queue keeps moving). Cluster routes missing from the cache are searched
+    // once per key, then each request assembles its own path; both phases run
+    // in parallel and write disjoint data.
+    static void ServeRequests(GameState& state) {
+        Service& service = state.pathfinding;
+        PathComponents& paths = state.paths;
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        
+        std::vector<Service::Request> batch;
+        std::vector<uint32_t> missing;
+        std::vector<std::vector<int32_t>> found;
+        const std::vector<int32_t> no_route;
+        uint32_t batches = 0;
+        
+        while (service.Backlog() > 0) {
+            // Live requests only: the entity may have changed goal since, and
+            // the same entity must not appear twice in one batch
+            batch.clear();
+            while (batch.size() < BATCH_SIZE && service.queue_head < service.queue.size()) {
+                const Service::Request& request = service.queue[service.queue_head++];
+                if (paths.status[request.entity] != PathStatus::PENDING ||
+                    paths.goal_cell[request.entity] != request.goal_cell) continue;
+                bool duplicate = std::any_of(batch.begin(), batch.end(),
+                    [&request](const Service::Request& other) { return other.entity == request.entity; });
+                if (!duplicate) batch.push_back(request);
+            }
+            
+            missing.clear();
+            for (const Service::Request& request : batch) {
+                int from = Pathfinding::ClusterOf(request.start_cell);
+                int to = Pathfinding::ClusterOf(request.goal_cell);
+                if (from == to) continue;
+                uint32_t key = Pathfinding::RouteKey(from, to);
+                if (service.route_cache.count(key)) {
+                    service.cache_hits++;
+                } else if (std::find(missing.begin(), missing.end(), key) == missing.end()) {
+                    missing.push_back(key);
+                    service.cache_misses++;
+                } else {
+                    service.cache_hits++;
+                }
+            }
+            
+            found.assign(missing.size(), {});
+            Parallel::For(0, missing.size(), 1, [&](size_t first, size_t last) {
+                for (size_t k = first; k < last; ++k) {
+                    int from = static_cast<int>(missing[k] / Service::CLUSTER_COUNT);
+                    int to = static_cast<int>(missing[k] % Service::CLUSTER_COUNT);
+                    found[k] = Pathfinding::FindClusterRoute(state.obstacles, service.graph, from, to);
+                }
+            });
+            for (size_t k = 0; k < missing.size(); ++k) {
+                service.route_cache.emplace(missing[k], std::move(found[k]));
+            }
+            
+            Parallel::For(0, batch.size(), 4, [&](size_t first, size_t last) {
+                thread_local std::vector<int32_t> cells;
+                for (size_t k = first; k < last; ++k) {
+                    const Service::Request& request = batch[k];
+                    int from = Pathfinding::ClusterOf(request.start_cell);
+                    int to = Pathfinding::ClusterOf(request.goal_cell);
+                    const std::vector<int32_t>& route =
+                        from == to ? no_route : service.route_cache.at(Pathfinding::RouteKey(from, to));
+                    
+                    const EntityID i = request.entity;
+                    if (Pathfinding::AssemblePath(state.obstacles, request.start_cell, request.goal_cell, route, cells)) {
+                        Pathfinding::SmoothPath(state.obstacles, state.transforms.position_x[i],
+                                                state.transforms.position_y[i], cells, paths.waypoints[i]);
+                        paths.cursor[i] = 0;
+                        paths.status[i] = PathStatus::READY;
+                    } else {
+                        paths.status[i] = PathStatus::FAILED;
+                    }
+                }
+            });
+            service.completed += batch.size();
+            
+            if (service.frame_batch_limit > 0) {
+                if (++batches >= service.frame_batch_limit) break;
+                continue;
             }
+            double elapsed_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - start_time).count();
+            if (elapsed_ms >= service.frame_budget_ms) break;
+        }
+        
+        if (service.Backlog() == 0) {
+            service.queue.clear();
+            service.queue_head = 0;
+        }
+    }
+    
+    static void FollowPaths(GameState& state) {
+        PathComponents& paths = state.paths;
+        const float arrival_sq = ARRIVAL_RADIUS * ARRIVAL_RADIUS;
+        for (EntityID i = 0; i < state.entity_count; ++i) {
+            if (paths.status[i] != PathStatus::READY) continue;
+            
+            const std::vector<Waypoint>& waypoints = paths.waypoints[i];
+            const float x = state.transforms.position_x[i];
+            const float y = state.transforms.position_y[i];
+            uint16_t& cursor = paths.cursor[i];
+            while (cursor < waypoints.size()) {
+                float dx = waypoints[cursor].x - x;
+                float dy = waypoints[cursor].y - y;
+                if (dx * dx + dy * dy >= arrival_sq) break;
+                cursor++;
+            }
+            if (cursor >= waypoints.size()) continue; // Last leg: straight at the target
+            
+            const Waypoint& next = waypoints[cursor];
+            if (!Pathfinding::LineOfSight(state.obstacles, x, y, next.x, next.y)) {
+                // Pushed off the route; ask again next frame
+                paths.status[i] = PathStatus::NONE;
+                paths.goal_cell[i] = -1;
+                continue;
+            }
+            float dx = next.x - x;
+            float dy = next.y - y;
+            float inv_distance = 1.0f / std::sqrt(dx * dx + dy * dy);
+            state.steering.guide_x[i] = dx * inv_distance;
+            state.steering.guide_y[i] = dy * inv_distance;
         }
     }
 };
@@ -195,13 +1183,103 @@ class KineticSystem {
 public:
     static constexpr float MAX_SPEED = 5.0f;
     static constexpr float ACCELERATION = 2.0f;
+    static constexpr float DECELERATION = 0.9f; // Velocity kept per frame when idle
+    static constexpr float SEPARATION_GAIN = 4.0f; // Acceleration per unit of crowd push
+    
+    // With an approximate policy the SIMD kernel normalizes with rsqrt + one
+    // Newton step (~1e-7 relative error) instead of sqrt and divide; use
+    // FastMath::Exact for bit-exact agreement with the scalar reference path,
+    // which always uses libm.
+    using Math = FastMath::Fast;
+    static constexpr bool FAST_MATH = Math::APPROXIMATE;
+    
+    static constexpr ComponentMask READS = Component::ACTIONS | Component::TRANSFORMS |
+        Component::HEALTH | Component::LOD | Component::STEERING | Component::NAVIGATION;
+    static constexpr ComponentMask WRITES = Component::TRANSFORMS | Component::LOD;
+    static constexpr ComponentMask CROSS_READS = Component::NONE;
+    
+    // Entities per job; a multiple of SIMD_WIDTH so every chunk but the last
+    // runs entirely in the vector kernel
+    static constexpr size_t CHUNK_SIZE = 1024;
+    static_assert(CHUNK_SIZE % SIMD_WIDTH == 0, "Kinetic chunks must stay SIMD-aligned");
     
+    // With stable chunks and NUMA binding, move every chunk of the arrays
+    // this system streams to the node of the worker that integrates it.
+    // Call after the entity arrays are allocated or grown.
+    static size_t PlaceRows(const GameState& state) {
+        size_t placed = 0;
+        auto place = [&state, &placed](const auto& column) {
+            placed += Parallel::PlaceColumn(column, state.entity_count, CHUNK_SIZE);
+        };
+        auto place_transforms = [&place](const TransformComponents& t) {
+            place(t.position_x); place(t.position_y); place(t.position_z);
+            place(t.velocity_x); place(t.velocity_y); place(t.velocity_z);
+            place(t.heading_x); place(t.heading_y);
+        };
+        auto place_actions = [&place](const ActionComponents& a) {
+            place(a.current_action); place(a.target_entity);
+            place(a.target_x); place(a.target_y); place(a.target_z);
+        };
+        place_transforms(state.transforms);
+        if (state.double_buffered & Component::TRANSFORMS) place_transforms(state.next_transforms);
+        place_actions(state.actions);
+        if (state.double_buffered & Component::ACTIONS) place_actions(state.next_actions);
+        place(state.steering.separation_x); place(state.steering.separation_y);
+        place(state.steering.guide_x); place(state.steering.guide_y);
+        place(state.lod.tier); place(state.lod.last_kinetic_frame);
+        return placed;
+    }
+    
+    // Entities only write their own rows, so chunks run on the job system
     static void Update(GameState& state, float delta_time) {
+        Parallel::For(0, state.entity_count, CHUNK_SIZE, [&state, delta_time](size_t begin, size_t end) {
+            UpdateRange(state, static_cast<EntityID>(begin), static_cast<EntityID>(end), delta_time);
+        });
+    }
+    
+    static void UpdateRange(GameState& state, EntityID begin, EntityID end, float delta_time) {
+        // Double-buffered: start frame N + 1 from frame N, then integrate in place
+        if (state.double_buffered & Component::TRANSFORMS) {
+            state.next_transforms.CopyRows(state.transforms, begin, end);
+        }
+#if defined(__AVX2__)
+        // Vectorize whole SIMD_WIDTH blocks. A range that ends at entity_count
+        // runs into the array padding instead of leaving a scalar tail; a range
+        // ending mid-array stops short so it never stores into a neighbour's lanes.
+        const EntityID width = static_cast<EntityID>(SIMD_WIDTH);
+        EntityID simd_begin = std::min(end, (begin + width - 1) / width * width);
+        EntityID simd_end = end == state.entity_count ? end : std::max(simd_begin, end / width * width);
+        UpdateRangeScalar(state, begin, simd_begin, delta_time);
+        UpdateRangeSimd<FAST_MATH>(state, simd_begin, simd_end, delta_time);
+        UpdateRangeScalar(state, simd_end, end, delta_time);
+#else
+        UpdateRangeScalar(state, begin, end, delta_time);
+#endif
+    }
+    
+    // Reference implementation; also handles range edges off the SIMD grid
+    static void UpdateRangeScalar(GameState& state, EntityID begin, EntityID end, float delta_time) {
+        TransformComponents& t = state.WrittenTransforms();
+        const GameState::LODConfig& lod = state.lod_config;
+        const uint32_t max_elapsed = lod.tier_period[GameState::LODConfig::TIER_COUNT - 1];
+        
         // Process all entities in a tight loop (cache-friendly)
-        for (EntityID i = 0; i < state.entity_count; ++i) {
+        for (EntityID i = begin; i < end; ++i) {
             if (!state.health.is_alive[i]) continue;
             
+            // Coarse LOD tiers integrate less often with a proportionally larger
+            // step. The step always covers the time since the last integration,
+            // so changing tier neither freezes nor fast-forwards an entity.
+            const uint32_t period = TimeSlicing::TierPeriod(state, i);
+            const uint32_t last = state.lod.last_kinetic_frame[i];
+            if (!TimeSlicing::IsDue(state, i, last, period)) continue;
+            
+            const uint32_t elapsed = std::max(1u, std::min(state.frame_index - last, max_elapsed));
+            const float dt = delta_time * static_cast<float>(elapsed);
+            state.lod.last_kinetic_frame[i] = state.frame_index;
+            
             ActionType action = state.actions.current_action[i];
+            float seek_distance = 0.0f;
             
             // Apply action-based movement
             if (action == ActionType::MOVE_TO_TARGET || 
@@ -210,8 +1288,8 @@ public:
                 
                 float target_x = state.actions.target_x[i];
                 float target_y = state.actions.target_y[i];
-                float current_x = state.transforms.position_x[i];
-                float current_y = state.transforms.position_y[i];
+                float current_x = t.position_x[i];
+                float current_y = t.position_y[i];
                 
                 // Calculate direction to target
                 float dx = target_x - current_x;
@@ -223,99 +1301,387 @@ public:
                     float dir_x = dx / distance;
                     float dir_y = dy / distance;
                     
-                    state.transforms.velocity_x[i] += dir_x * ACCELERATION * delta_time;
-                    state.transforms.velocity_y[i] += dir_y * ACCELERATION * delta_time;
+                    // A flow field or path overrides the straight line
+                    if (state.steering.guide_x[i] != 0.0f || state.steering.guide_y[i] != 0.0f) {
+                        dir_x = state.steering.guide_x[i];
+                        dir_y = state.steering.guide_y[i];
+                    }
+                    
+                    t.velocity_x[i] += dir_x * ACCELERATION * dt;
+                    t.velocity_y[i] += dir_y * ACCELERATION * dt;
+                    seek_distance = distance;
                     
-                    // Update orientation
-                    state.transforms.orientation[i] = std::atan2(dy, dx);
+                    // Face the direction of travel
+                    t.heading_x[i] = dir_x;
+                    t.heading_y[i] = dir_y;
                 }
             } else if (action == ActionType::FLEE) {
-                // Flee from nearest threat
-                if (!state.stimulus_buffer.visible_entities[i].empty()) {
-                    EntityID threat = state.stimulus_buffer.visible_entities[i][0];
-                    float threat_x = state.transforms.position_x[threat];
-                    float threat_y = state.transforms.position_y[threat];
-                    float current_x = state.transforms.position_x[i];
-                    float current_y = state.transforms.position_y[i];
-                    
-                    // Move away from threat
-                    float dx = current_x - threat_x;
-                    float dy = current_y - threat_y;
-                    float distance = std::sqrt(dx * dx + dy * dy);
+                // Flee from the threat point the UtilitySystem picked
+                float threat_x = state.actions.target_x[i];
+                float threat_y = state.actions.target_y[i];
+                float current_x = t.position_x[i];
+                float current_y = t.position_y[i];
+                
+                // Move away from threat
+                float dx = current_x - threat_x;
+                float dy = current_y - threat_y;
+                float distance = std::sqrt(dx * dx + dy * dy);
+                
+                if (distance > 0.1f) {
+                    float dir_x = dx / distance;
+                    float dir_y = dy / distance;
                     
-                    if (distance > 0.1f) {
-                        float dir_x = dx / distance;
-                        float dir_y = dy / distance;
-                        
-                        state.transforms.velocity_x[i] += dir_x * ACCELERATION * 1.5f * delta_time;
-                        state.transforms.velocity_y[i] += dir_y * ACCELERATION * 1.5f * delta_time;
-                    }
+                    t.velocity_x[i] += dir_x * ACCELERATION * 1.5f * dt;
+                    t.velocity_y[i] += dir_y * ACCELERATION * 1.5f * dt;
                 }
             } else if (action == ActionType::SLEEP || action == ActionType::IDLE) {
-                // Decelerate
-                state.transforms.velocity_x[i] *= 0.9f;
-                state.transforms.velocity_y[i] *= 0.9f;
+                // Decelerate (compounded over every frame this step covers)
+                float decay = elapsed == 1 ? DECELERATION
+                                           : std::pow(DECELERATION, static_cast<float>(elapsed));
+                t.velocity_x[i] *= decay;
+                t.velocity_y[i] *= decay;
             }
             
+            // Crowd separation
+            t.velocity_x[i] += state.steering.separation_x[i] * SEPARATION_GAIN * dt;
+            t.velocity_y[i] += state.steering.separation_y[i] * SEPARATION_GAIN * dt;
+            
             // Clamp velocity to max speed
-            float speed_sq = state.transforms.velocity_x[i] * state.transforms.velocity_x[i] +
-                           state.transforms.velocity_y[i] * state.transforms.velocity_y[i];
+            float speed_sq = t.velocity_x[i] * t.velocity_x[i] +
+                           t.velocity_y[i] * t.velocity_y[i];
             
             if (speed_sq > MAX_SPEED * MAX_SPEED) {
                 float speed = std::sqrt(speed_sq);
-                state.transforms.velocity_x[i] = (state.transforms.velocity_x[i] / speed) * MAX_SPEED;
-                state.transforms.velocity_y[i] = (state.transforms.velocity_y[i] / speed) * MAX_SPEED;
+                t.velocity_x[i] = (t.velocity_x[i] / speed) * MAX_SPEED;
+                t.velocity_y[i] = (t.velocity_y[i] / speed) * MAX_SPEED;
+            }
+            
+            // A long coarse step must not carry a seeker past its target
+            if (elapsed > 1 && seek_distance > 0.0f) {
+                float step = std::sqrt(t.velocity_x[i] * t.velocity_x[i] +
+                                       t.velocity_y[i] * t.velocity_y[i]) * dt;
+                if (step > seek_distance) {
+                    float scale = seek_distance / step;
+                    t.velocity_x[i] *= scale;
+                    t.velocity_y[i] *= scale;
+                }
             }
             
             // Integrate position
-            state.transforms.position_x[i] += state.transforms.velocity_x[i] * delta_time;
-            state.transforms.position_y[i] += state.transforms.velocity_y[i] * delta_time;
+            const float old_x = t.position_x[i];
+            const float old_y = t.position_y[i];
+            t.position_x[i] += t.velocity_x[i] * dt;
+            t.position_y[i] += t.velocity_y[i] * dt;
             
             // Simple world bounds
-            state.transforms.position_x[i] = std::max(0.0f, std::min(1000.0f, state.transforms.position_x[i]));
-            state.transforms.position_y[i] = std::max(0.0f, std::min(1000.0f, state.transforms.position_y[i]));
+            t.position_x[i] = std::max(0.0f, std::min(1000.0f, t.position_x[i]));
+            t.position_y[i] = std::max(0.0f, std::min(1000.0f, t.position_y[i]));
+            
+            if (state.obstacles.blocked_count > 0) SlideAlongObstacles(state, i, old_x, old_y);
+        }
+    }
+    
+    // A step that ends in a blocked cell keeps whichever axis of the move
+    // stays open (sliding along the wall), or is undone entirely
+    static void SlideAlongObstacles(GameState& state, EntityID i, float old_x, float old_y) {
+        TransformComponents& t = state.WrittenTransforms();
+        const GameState::ObstacleMap& obstacles = state.obstacles;
+        if (!obstacles.IsBlockedAt(t.position_x[i], t.position_y[i])) return;
+        if (!obstacles.IsBlockedAt(old_x, t.position_y[i])) {
+            t.position_x[i] = old_x;
+            t.velocity_x[i] = 0.0f;
+        } else if (!obstacles.IsBlockedAt(t.position_x[i], old_y)) {
+            t.position_y[i] = old_y;
+            t.velocity_y[i] = 0.0f;
+        } else {
+            t.position_x[i] = old_x;
+            t.position_y[i] = old_y;
+            t.velocity_x[i] = 0.0f;
+            t.velocity_y[i] = 0.0f;
         }
     }
+    
+#if defined(__AVX2__)
+    // All action branches evaluated for 8 entities at once and merged with
+    // masks. `begin` must be SIMD-aligned; lanes at or past `end` are inert.
+    template <bool FAST>
+    static void UpdateRangeSimd(GameState& state, EntityID begin, EntityID end, float delta_time) {
+        TransformComponents& t = state.WrittenTransforms();
+        ActionComponents& a = state.actions;
+        const uint32_t max_elapsed = state.lod_config.tier_period[GameState::LODConfig::TIER_COUNT - 1];
+        
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 accel = _mm256_set1_ps(ACCELERATION);
+        const __m256 flee_gain = _mm256_set1_ps(1.5f);
+        const __m256 min_distance = _mm256_set1_ps(0.1f);
+        const __m256 max_speed = _mm256_set1_ps(MAX_SPEED);
+        const __m256 max_speed_sq = _mm256_set1_ps(MAX_SPEED * MAX_SPEED);
+        const __m256 world_max = _mm256_set1_ps(1000.0f);
+        
+        for (EntityID base = begin; base < end; base += SIMD_WIDTH) {
+            // Per-lane schedule (integer LOD bookkeeping): step length 0 = inactive
+            alignas(32) float step_dt[SIMD_WIDTH];
+            alignas(32) float decay_factor[SIMD_WIDTH];
+            alignas(32) float coarse_step[SIMD_WIDTH];
+            for (size_t lane = 0; lane < SIMD_WIDTH; ++lane) {
+                EntityID i = base + static_cast<EntityID>(lane);
+                step_dt[lane] = 0.0f;
+                decay_factor[lane] = 1.0f;
+                coarse_step[lane] = 0.0f;
+                if (i >= end || !state.health.is_alive[i]) continue;
+                
+                const uint32_t last = state.lod.last_kinetic_frame[i];
+                if (!TimeSlicing::IsDue(state, i, last, TimeSlicing::TierPeriod(state, i))) continue;
+                
+                const uint32_t elapsed = std::max(1u, std::min(state.frame_index - last, max_elapsed));
+                state.lod.last_kinetic_frame[i] = state.frame_index;
+                step_dt[lane] = delta_time * static_cast<float>(elapsed);
+                decay_factor[lane] = elapsed == 1 ? DECELERATION
+                                                  : std::pow(DECELERATION, static_cast<float>(elapsed));
+                coarse_step[lane] = elapsed > 1 ? 1.0f : 0.0f;
+            }
+            
+            const __m256 dt = _mm256_load_ps(step_dt);
+            const __m256 active = _mm256_cmp_ps(dt, zero, _CMP_GT_OQ);
+            
+            const __m256 px = _mm256_load_ps(&t.position_x[base]);
+            const __m256 py = _mm256_load_ps(&t.position_y[base]);
+            __m256 vx = _mm256_load_ps(&t.velocity_x[base]);
+            __m256 vy = _mm256_load_ps(&t.velocity_y[base]);
+            const __m256 tx = _mm256_load_ps(&a.target_x[base]);
+            const __m256 ty = _mm256_load_ps(&a.target_y[base]);
+            
+            // Action masks
+            const __m256i action = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&a.current_action[base])));
+            auto is = [&action](ActionType type) {
+                return _mm256_castsi256_ps(_mm256_cmpeq_epi32(action, _mm256_set1_epi32(static_cast<int>(type))));
+            };
+            const __m256 seek = _mm256_or_ps(_mm256_or_ps(is(ActionType::MOVE_TO_TARGET), is(ActionType::ATTACK)),
+                                             is(ActionType::EXPLORE));
+            const __m256 flee = is(ActionType::FLEE);
+            const __m256 stop = _mm256_or_ps(is(ActionType::SLEEP), is(ActionType::IDLE));
+            
+            // Steering: seekers head for the target, fleers directly away from it
+            const __m256 dx = _mm256_blendv_ps(_mm256_sub_ps(tx, px), _mm256_sub_ps(px, tx), flee);
+            const __m256 dy = _mm256_blendv_ps(_mm256_sub_ps(ty, py), _mm256_sub_ps(py, ty), flee);
+            const __m256 distance_sq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 distance, dir_x, dir_y;
+            if (FAST) {
+                __m256 inv_distance = Rsqrt(distance_sq);
+                distance = _mm256_mul_ps(distance_sq, inv_distance);
+                dir_x = _mm256_mul_ps(dx, inv_distance);
+                dir_y = _mm256_mul_ps(dy, inv_distance);
+            } else {
+                distance = _mm256_sqrt_ps(distance_sq);
+                dir_x = _mm256_div_ps(dx, distance);
+                dir_y = _mm256_div_ps(dy, distance);
+            }
+            // A flow field or path overrides the straight line for seekers
+            const __m256 fx = _mm256_load_ps(&state.steering.guide_x[base]);
+            const __m256 fy = _mm256_load_ps(&state.steering.guide_y[base]);
+            const __m256 follow = _mm256_and_ps(seek, _mm256_or_ps(_mm256_cmp_ps(fx, zero, _CMP_NEQ_OQ),
+                                                                   _mm256_cmp_ps(fy, zero, _CMP_NEQ_OQ)));
+            dir_x = _mm256_blendv_ps(dir_x, fx, follow);
+            dir_y = _mm256_blendv_ps(dir_y, fy, follow);
+            const __m256 steer = _mm256_and_ps(_mm256_or_ps(seek, flee),
+                                               _mm256_cmp_ps(distance, min_distance, _CMP_GT_OQ));
+            const __m256 gain = _mm256_blendv_ps(one, flee_gain, flee);
+            vx = _mm256_blendv_ps(vx, _mm256_add_ps(vx, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(dir_x, accel), gain), dt)), steer);
+            vy = _mm256_blendv_ps(vy, _mm256_add_ps(vy, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(dir_y, accel), gain), dt)), steer);
+            const __m256 seek_steer = _mm256_and_ps(_mm256_and_ps(steer, seek), active);
+            const __m256 seek_distance = _mm256_and_ps(seek_steer, distance);
+            
+            // Face the direction of travel
+            _mm256_store_ps(&t.heading_x[base], _mm256_blendv_ps(_mm256_load_ps(&t.heading_x[base]), dir_x, seek_steer));
+            _mm256_store_ps(&t.heading_y[base], _mm256_blendv_ps(_mm256_load_ps(&t.heading_y[base]), dir_y, seek_steer));
+            
+            // Decelerate
+            const __m256 decay = _mm256_load_ps(decay_factor);
+            vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, decay), stop);
+            vy = _mm256_blendv_ps(vy, _mm256_mul_ps(vy, decay), stop);
+            
+            // Crowd separation
+            const __m256 separation_gain = _mm256_set1_ps(SEPARATION_GAIN);
+            vx = _mm256_add_ps(vx, _mm256_mul_ps(_mm256_mul_ps(_mm256_load_ps(&state.steering.separation_x[base]), separation_gain), dt));
+            vy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_mul_ps(_mm256_load_ps(&state.steering.separation_y[base]), separation_gain), dt));
+            
+            // Clamp velocity to max speed
+            const __m256 speed_sq = _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy));
+            const __m256 too_fast = _mm256_cmp_ps(speed_sq, max_speed_sq, _CMP_GT_OQ);
+            if (FAST) {
+                __m256 scale = _mm256_mul_ps(Rsqrt(speed_sq), max_speed);
+                vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, scale), too_fast);
+                vy = _mm256_blendv_ps(vy, _mm256_mul_ps(vy, scale), too_fast);
+            } else {
+                __m256 speed = _mm256_sqrt_ps(speed_sq);
+                vx = _mm256_blendv_ps(vx, _mm256_mul_ps(_mm256_div_ps(vx, speed), max_speed), too_fast);
+                vy = _mm256_blendv_ps(vy, _mm256_mul_ps(_mm256_div_ps(vy, speed), max_speed), too_fast);
+            }
+            
+            // A long coarse step must not carry a seeker past its target
+            const __m256 coarse = _mm256_cmp_ps(_mm256_load_ps(coarse_step), zero, _CMP_GT_OQ);
+            const __m256 new_speed_sq = _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy));
+            const __m256 new_speed = FAST ? _mm256_mul_ps(new_speed_sq, Rsqrt(new_speed_sq))
+                                          : _mm256_sqrt_ps(new_speed_sq);
+            const __m256 step = _mm256_mul_ps(new_speed, dt);
+            const __m256 overshoot = _mm256_and_ps(
+                _mm256_and_ps(coarse, _mm256_cmp_ps(seek_distance, zero, _CMP_GT_OQ)),
+                _mm256_cmp_ps(step, seek_distance, _CMP_GT_OQ));
+            const __m256 shrink = _mm256_div_ps(seek_distance, step);
+            vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, shrink), overshoot);
+            vy = _mm256_blendv_ps(vy, _mm256_mul_ps(vy, shrink), overshoot);
+            
+            // Integrate position and clamp to world bounds
+            __m256 nx = _mm256_add_ps(px, _mm256_mul_ps(vx, dt));
+            __m256 ny = _mm256_add_ps(py, _mm256_mul_ps(vy, dt));
+            nx = _mm256_max_ps(_mm256_min_ps(nx, world_max), zero);
+            ny = _mm256_max_ps(_mm256_min_ps(ny, world_max), zero);
+            
+            // Inactive lanes keep their previous values
+            _mm256_store_ps(&t.position_x[base], _mm256_blendv_ps(px, nx, active));
+            _mm256_store_ps(&t.position_y[base], _mm256_blendv_ps(py, ny, active));
+            _mm256_store_ps(&t.velocity_x[base], _mm256_blendv_ps(_mm256_load_ps(&t.velocity_x[base]), vx, active));
+            _mm256_store_ps(&t.velocity_y[base], _mm256_blendv_ps(_mm256_load_ps(&t.velocity_y[base]), vy, active));
+            
+            if (state.obstacles.blocked_count > 0) {
+                alignas(32) float old_x[SIMD_WIDTH];
+                alignas(32) float old_y[SIMD_WIDTH];
+                _mm256_store_ps(old_x, px);
+                _mm256_store_ps(old_y, py);
+                for (size_t lane = 0; lane < SIMD_WIDTH; ++lane) {
+                    if (step_dt[lane] > 0.0f) SlideAlongObstacles(state, base + static_cast<EntityID>(lane), old_x[lane], old_y[lane]);
+                }
+            }
+        }
+    }
+    
+    // 1/sqrt(x) from the hardware estimate refined by one Newton-Raphson step
+    static __m256 Rsqrt(__m256 x) {
+        const __m256 estimate = _mm256_rsqrt_ps(x);
+        const __m256 half_x = _mm256_mul_ps(x, _mm256_set1_ps(0.5f));
+        const __m256 correction = _mm256_sub_ps(_mm256_set1_ps(1.5f),
+            _mm256_mul_ps(half_x, _mm256_mul_ps(estimate, estimate)));
+        return _mm256_mul_ps(estimate, correction);
+    }
+    
+    // Validation mode: run the scalar path and both SIMD variants on copies of
+    // the state. The exact SIMD kernel must match scalar bit for bit; the fast
+    // one is reported as its largest deviation.
+    struct SimdValidation {
+        size_t exact_mismatches = 0;
+        float fast_max_error = 0.0f;
+    };
+    
+    static SimdValidation CompareSimdWithScalar(const GameState& state, float delta_time) {
+        const EntityID count = static_cast<EntityID>(state.entity_count);
+        GameState scalar = state;
+        scalar.double_buffered = Component::NONE; // The kernels integrate the copies in place
+        GameState exact = scalar;
+        GameState fast = scalar;
+        UpdateRangeScalar(scalar, 0, count, delta_time);
+        UpdateRangeSimd<false>(exact, 0, count, delta_time);
+        UpdateRangeSimd<true>(fast, 0, count, delta_time);
+        
+        SimdValidation result;
+        auto compare = [&](const AlignedVector<float>& ref, const AlignedVector<float>& exact_values,
+                           const AlignedVector<float>& fast_values) {
+            for (EntityID i = 0; i < count; ++i) {
+                if (std::memcmp(&ref[i], &exact_values[i], sizeof(float)) != 0) result.exact_mismatches++;
+                result.fast_max_error = std::max(result.fast_max_error, std::abs(ref[i] - fast_values[i]));
+            }
+        };
+        compare(scalar.transforms.position_x, exact.transforms.position_x, fast.transforms.position_x);
+        compare(scalar.transforms.position_y, exact.transforms.position_y, fast.transforms.position_y);
+        compare(scalar.transforms.velocity_x, exact.transforms.velocity_x, fast.transforms.velocity_x);
+        compare(scalar.transforms.velocity_y, exact.transforms.velocity_y, fast.transforms.velocity_y);
+        compare(scalar.transforms.heading_x, exact.transforms.heading_x, fast.transforms.heading_x);
+        compare(scalar.transforms.heading_y, exact.transforms.heading_y, fast.transforms.heading_y);
+        return result;
+    }
+#endif
 };
 
 // ============================================================================
 // NEEDS SYSTEM - Updates entity needs over time
+// Entities that are sleeping or LOD-demoted are not stepped every frame; their
+// needs are settled in closed form when they are next due or next read.
 // ============================================================================
 class NeedsSystem {
 public:
+    static constexpr ComponentMask READS = Component::NEEDS | Component::ACTIONS |
+        Component::HEALTH | Component::LOD;
+    static constexpr ComponentMask WRITES = Component::NEEDS;
+    static constexpr ComponentMask CROSS_READS = Component::NONE;
+    
     static void Update(GameState& state, float delta_time) {
-        for (EntityID i = 0; i < state.entity_count; ++i) {
+        UpdateRange(state, 0, static_cast<EntityID>(state.entity_count), delta_time);
+    }
+    
+    static void UpdateRange(GameState& state, EntityID begin, EntityID end, float delta_time) {
+        for (EntityID i = begin; i < end; ++i) {
             if (!state.health.is_alive[i]) continue;
             
-            ActionType action = state.actions.current_action[i];
+            // Sleepers are settled by their next decision
+            if (state.actions.current_action[i] == ActionType::SLEEP) continue;
             
-            // Hunger increases over time
-            state.needs.hunger[i] = std::min(1.0f, state.needs.hunger[i] + 0.01f * delta_time);
-            
-            // Energy decreases when active, increases when sleeping
-            if (action == ActionType::SLEEP) {
-                state.needs.energy[i] = std::min(1.0f, state.needs.energy[i] + 0.1f * delta_time);
-            } else {
-                state.needs.energy[i] = std::max(0.0f, state.needs.energy[i] - 0.02f * delta_time);
-            }
-            
-            // Eating reduces hunger
-            if (action == ActionType::EAT) {
-                state.needs.hunger[i] = std::max(0.0f, state.needs.hunger[i] - 0.15f * delta_time);
-            }
+            const uint32_t last = state.needs.last_update_frame[i];
+            if (!TimeSlicing::IsDue(state, i, last, TimeSlicing::TierPeriod(state, i))) continue;
             
-            // Safety based on nearby entities
-            if (state.perception.visible_entity_count[i] > 3) {
-                state.needs.safety[i] = std::max(0.0f, state.needs.safety[i] - 0.05f * delta_time);
-            } else {
-                state.needs.safety[i] = std::min(1.0f, state.needs.safety[i] + 0.03f * delta_time);
-            }
-            
-            // Curiosity fluctuates
-            state.needs.curiosity[i] += (rand() % 100 - 50) * 0.001f * delta_time;
-            state.needs.curiosity[i] = std::max(0.0f, std::min(1.0f, state.needs.curiosity[i]));
+            NeedsModel::Resolve(state, i, state.frame_index, delta_time);
+        }
+    }
+    
+    // Batch catch-up, e.g. before taking a snapshot of every entity's needs
+    static void ResolveAll(GameState& state, uint32_t through_frame, float delta_time) {
+        for (EntityID i = 0; i < state.entity_count; ++i) {
+            if (!state.health.is_alive[i]) continue;
+            NeedsModel::Resolve(state, i, through_frame, delta_time);
+        }
+    }
+};
+
+// ============================================================================
+// SYSTEM FUSION - Run adjacent systems in one pass over entity chunks
+// Instead of streaming every component array through the cache once per
+// system, each chunk is run through First and then Second while its rows are
+// still hot. This is legal when neither system reads, for *other* entities,
+// anything the other writes: per entity the First-then-Second order is kept,
+// and no chunk can observe another chunk's half-finished state.
+// ============================================================================
+template <typename First, typename Second>
+class FusedSystem {
+public:
+    static constexpr bool CAN_FUSE =
+        (First::WRITES & Second::CROSS_READS) == 0 &&
+        (Second::WRITES & First::CROSS_READS) == 0;
+    static_assert(CAN_FUSE, "Systems share cross-entity data and cannot be fused");
+    
+    static constexpr ComponentMask READS = First::READS | Second::READS;
+    static constexpr ComponentMask WRITES = First::WRITES | Second::WRITES;
+    static constexpr ComponentMask CROSS_READS = First::CROSS_READS | Second::CROSS_READS;
+    
+    // Entities per chunk: small enough that a chunk's rows stay in L1/L2
+    static constexpr EntityID CHUNK_SIZE = 256;
+    
+    static void Update(GameState& state, float delta_time) {
+        UpdateRange(state, 0, static_cast<EntityID>(state.entity_count), delta_time);
+    }
+    
+    static void UpdateRange(GameState& state, EntityID begin, EntityID end, float delta_time) {
+        for (EntityID chunk = begin; chunk < end; chunk += std::min(CHUNK_SIZE, end - chunk)) {
+            EntityID chunk_end = chunk + std::min(CHUNK_SIZE, end - chunk);
+            First::UpdateRange(state, chunk, chunk_end, delta_time);
+            Second::UpdateRange(state, chunk, chunk_end, delta_time);
         }
     }
 };
 
+// Needs of frame N fused with Utility of frame N+1 (one-frame shift): the
+// needs step runs at the start of the next frame, after perception, instead
+// of at the end of this one. It still uses the action decided last frame, but
+// sees this frame's perception, and Utility then decides from fresh needs.
+using NeedsUtilitySystem = FusedSystem<NeedsSystem, UtilitySystem>;
+
 } // namespace Systems
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Components.h"
+#include "Parallel.h"
+#include "Scheduler.h"
+#include "Systems.h"
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+// ============================================================================
+// WORLDS - "The Multiverse"
+// Many independent GameStates in one process, stepped together on the
+// shared job system. Each world keeps its own schedule. Small worlds are
+// packed into batches that run as one job each, serially inside, so a
+// frame of a thousand-entity world is not split into jobs smaller than
+// their own overhead. Worlds above the batch size get a job of their own,
+// and their systems fan out across the pool as usual.
+// ============================================================================
+
+namespace Worlds {
+
+struct World {
+    GameState state;
+    Scheduling::SystemScheduler scheduler;
+    size_t index = 0;
+};
+
+// Totals over every world, for Monte-Carlo style runs
+struct Summary {
+    size_t worlds = 0;
+    size_t entities = 0;
+    size_t alive = 0;
+    uint64_t actions[static_cast<size_t>(ActionType::COUNT)] = {}; // Alive entities per action
+    double hunger_sum = 0.0;                                       // Over alive entities
+    double energy_sum = 0.0;
+    
+    void Add(const GameState& state) {
+        worlds++;
+        entities += state.entity_count;
+        for (EntityID i = 0; i < state.entity_count; ++i) {
+            if (!state.health.is_alive[i]) continue;
+            alive++;
+            actions[static_cast<size_t>(state.actions.current_action[i])]++;
+            hunger_sum += state.needs.hunger[i];
+            energy_sum += state.needs.energy[i];
+        }
+    }
+    
+    void Merge(const Summary& other) {
+        worlds += other.worlds;
+        entities += other.entities;
+        alive += other.alive;
+        for (size_t a = 0; a < static_cast<size_t>(ActionType::COUNT); ++a) actions[a] += other.actions[a];
+        hunger_sum += other.hunger_sum;
+        energy_sum += other.energy_sum;
+    }
+    
+    double MeanHunger() const { return alive ? hunger_sum / alive : 0.0; }
+    double MeanEnergy() const { return alive ? energy_sum / alive : 0.0; }
+};
+
+class WorldRunner {
+public:
+    // Fills in a new world's state and registers its systems
+    using Setup = std::function<void(World&)>;
+    
+    // Worlds with fewer entities than this share a job with their neighbours
+    explicit WorldRunner(size_t batch_entities = 4096) : batch_entities(batch_entities) {}
+    
+    World& AddWorld(const Setup& setup) {
+        worlds.push_back(std::make_unique<World>());
+        World& world = *worlds.back();
+        world.index = worlds.size() - 1;
+        setup(world);
+        batches_dirty = true;
+        return world;
+    }
+    
+    size_t WorldCount() const { return worlds.size(); }
+    size_t BatchCount() { PlanBatches(); return batches.size(); }
+    World& GetWorld(size_t index) { return *worlds[index]; }
+    
+    // One frame of every world
+    void Step() {
+        PlanBatches();
+        Parallel::JobGroup group;
+        for (size_t b = 1; b < batches.size(); ++b) {
+            Parallel::Submit(group, [this, b]() { RunBatch(batches[b]); });
+        }
+        if (!batches.empty()) RunBatch(batches[0]);
+        Parallel::Wait(group);
+    }
+    
+    // Per-world summaries, merged in world order. Lazy needs are settled
+    // through each world's last frame first, so the means are not stale.
+    Summary Aggregate(float delta_time) {
+        std::vector<Summary> partials(worlds.size());
+        Parallel::For(0, worlds.size(), 1, [this, &partials, delta_time](size_t first, size_t last) {
+            for (size_t w = first; w < last; ++w) {
+                GameState& state = worlds[w]->state;
+                Systems::NeedsSystem::ResolveAll(state, state.frame_index - 1, delta_time);
+                partials[w].Add(state);
+            }
+        });
+        Summary total;
+        for (const Summary& partial : partials) total.Merge(partial);
+        return total;
+    }
+    
+    // Runs the trailing stages every world's last frame left behind
+    void Finish() {
+        for (auto& world : worlds) world->scheduler.Finish();
+    }
+
+private:
+    struct Batch {
+        size_t first;
+        size_t last;
+        bool serial; // Small worlds only: run their systems in place
+    };
+    
+    size_t batch_entities;
+    std::vector<std::unique_ptr<World>> worlds;
+    std::vector<Batch> batches;
+    bool batches_dirty = true;
+    
+    // Consecutive small worlds fill a batch up to batch_entities; a large
+    // world is a batch by itself
+    void PlanBatches() {
+        if (!batches_dirty) return;
+        batches.clear();
+        size_t w = 0;
+        while (w < worlds.size()) {
+            if (worlds[w]->state.entity_count >= batch_entities) {
+                batches.push_back({w, w + 1, false});
+                w++;
+                continue;
+            }
+            size_t first = w;
+            size_t entities = 0;
+            while (w < worlds.size() && worlds[w]->state.entity_count < batch_entities &&
+                   (w == first || entities + worlds[w]->state.entity_count <= batch_entities)) {
+                entities += worlds[w]->state.entity_count;
+                w++;
+            }
+            batches.push_back({first, w, true});
+        }
+        batches_dirty = false;
+    }
+    
+    void RunBatch(const Batch& batch) {
+        if (batch.serial) {
+            Parallel::SerialScope serial;
+            for (size_t w = batch.first; w < batch.last; ++w) RunFrame(*worlds[w]);
+        } else {
+            for (size_t w = batch.first; w < batch.last; ++w) RunFrame(*worlds[w]);
+        }
+    }
+    
+    static void RunFrame(World& world) {
+        world.scheduler.Run();
+        world.state.frame_index++;
+    }
+};
+
+} // namespace Worlds
@@ -1,32 +1,73 @@
 #include "../include/Components.h"
 #include "../include/Systems.h"
 #include "../include/Diagnostics.h"
+#include "../include/Scheduler.h"
+#include "../include/Determinism.h"
+#include "../include/Worlds.h"
+#include "../include/Sharding.h"
+#include "../include/Commands.h"
 #include <iostream>
 #include <random>
 #include <chrono>
+#include <sstream>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // ============================================================================
 // THE GAME LOOP - "The Heartbeat"
-// Linear pipeline of systems executing in sequence
+// Systems scheduled as a dependency graph of their component reads/writes
 // ============================================================================
 
-void InitializeEntities(GameState& state, size_t count) {
+// Static walls: straight runs of blocked grid cells with their own seed, so
+// toggling them leaves the entity layout stream untouched
+void InitializeObstacles(GameState& state, int wall_count) {
+    using Grid = GameState::SpatialGrid;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> cell_dist(0, Grid::GRID_SIZE - 1);
+    std::uniform_int_distribution<int> length_dist(5, 25);
+    
+    for (int wall = 0; wall < wall_count; ++wall) {
+        int x = cell_dist(rng);
+        int y = cell_dist(rng);
+        int length = length_dist(rng);
+        bool horizontal = rng() & 1;
+        for (int k = 0; k < length; ++k) {
+            int cx = horizontal ? x + k : x;
+            int cy = horizontal ? y : y + k;
+            if (cx >= Grid::GRID_SIZE || cy >= Grid::GRID_SIZE) break;
+            state.obstacles.SetBlocked(cx, cy, true);
+        }
+    }
+}
+
+void InitializeEntities(GameState& state, size_t count, int wall_count, uint32_t seed = 42) {
     state.Initialize(count);
+    InitializeObstacles(state, wall_count);
     
-    std::mt19937 rng(42); // Fixed seed for reproducibility
+    std::mt19937 rng(seed); // Fixed seed for reproducibility
     std::uniform_real_distribution<float> pos_dist(0.0f, 1000.0f);
     std::uniform_real_distribution<float> need_dist(0.0f, 1.0f);
     std::uniform_real_distribution<float> angle_dist(0.0f, 2.0f * M_PI);
     
     for (EntityID i = 0; i < count; ++i) {
-        // Initialize transforms
-        state.transforms.position_x[i] = pos_dist(rng);
-        state.transforms.position_y[i] = pos_dist(rng);
+        // Initialize transforms (never inside a wall)
+        do {
+            state.transforms.position_x[i] = pos_dist(rng);
+            state.transforms.position_y[i] = pos_dist(rng);
+        } while (state.obstacles.IsBlockedAt(state.transforms.position_x[i], state.transforms.position_y[i]));
         state.transforms.position_z[i] = 0.0f;
         state.transforms.velocity_x[i] = 0.0f;
         state.transforms.velocity_y[i] = 0.0f;
         state.transforms.velocity_z[i] = 0.0f;
-        state.transforms.orientation[i] = angle_dist(rng);
+        float facing = angle_dist(rng);
+        state.transforms.heading_x[i] = std::cos(facing);
+        state.transforms.heading_y[i] = std::sin(facing);
         
         // Initialize perception
         state.perception.view_range[i] = 50.0f + (i % 50);
@@ -53,11 +94,13 @@ void InitializeEntities(GameState& state, size_t count) {
         state.health.armor_type[i] = i % 3;
         state.health.is_alive[i] = true;
     }
-    
-    std::cout << "Initialized " << count << " entities" << std::endl;
 }
 
-void PrintSimulationStats(const GameState& state, int frame) {
+// Everything PrintSimulationStats looks at
+const ComponentMask SIMULATION_STATS_READS = Component::HEALTH | Component::LOD | Component::PATHS |
+    Component::ACTIONS | Component::NAVIGATION | Component::STIMULUS | Component::FLOW_FIELDS;
+
+void PrintSimulationStats(const GameState& state, int frame, std::ostream& out = std::cout) {
     // Count entities by action
     int idle_count = 0;
     int move_count = 0;
@@ -67,10 +110,14 @@ void PrintSimulationStats(const GameState& state, int frame) {
     int attack_count = 0;
     int explore_count = 0;
     int alive_count = 0;
+    int tier_counts[GameState::LODConfig::TIER_COUNT] = {};
+    int route_count = 0;
     
     for (EntityID i = 0; i < state.entity_count; ++i) {
         if (!state.health.is_alive[i]) continue;
         alive_count++;
+        tier_counts[state.lod.tier[i]]++;
+        if (state.paths.status[i] == PathStatus::READY) route_count++;
         
         switch (state.actions.current_action[i]) {
             case ActionType::IDLE: idle_count++; break;
@@ -84,18 +131,73 @@ void PrintSimulationStats(const GameState& state, int frame) {
         }
     }
     
-    std::cout << "\n=== FRAME " << frame << " STATS ===" << std::endl;
-    std::cout << "Alive: " << alive_count << "/" << state.entity_count << std::endl;
-    std::cout << "Actions - Idle: " << idle_count 
+    out << "\n=== FRAME " << frame << " STATS ===" << std::endl;
+    out << "Alive: " << alive_count << "/" << state.entity_count << std::endl;
+    out << "Actions - Idle: " << idle_count 
               << " | Move: " << move_count
               << " | Eat: " << eat_count
               << " | Sleep: " << sleep_count
               << " | Flee: " << flee_count
               << " | Attack: " << attack_count
               << " | Explore: " << explore_count << std::endl;
-    std::cout << "============================\n" << std::endl;
+    out << "LOD Tiers -";
+    for (int tier = 0; tier < GameState::LODConfig::TIER_COUNT; ++tier) {
+        out << (tier ? " |" : "") << " " << tier << ": " << tier_counts[tier];
+    }
+    out << std::endl;
+    out << "Paths - following: " << route_count
+              << " | pending: " << state.pathfinding.Backlog()
+              << " | served: " << state.pathfinding.completed
+              << " | cache hits/misses: " << state.pathfinding.cache_hits
+              << "/" << state.pathfinding.cache_misses << std::endl;
+    if (state.stimulus_buffer.build_visibility_events) {
+        out << "Visibility - entered: " << state.stimulus_buffer.entered.size()
+                  << " | exited: " << state.stimulus_buffer.exited.size() << std::endl;
+    }
+    out << "Flow Fields - cached: " << state.flow_fields.fields.size()
+              << " | built: " << state.flow_fields.builds
+              << " | reused: " << state.flow_fields.reuses << std::endl;
+    out << "============================\n" << std::endl;
 }
 
+// Stand-in for external producers (a network frontend, scripted events):
+// threads posting random spawns, teleports and need changes until destroyed
+class CommandFeed {
+public:
+    CommandFeed(Commands::CommandQueue& queue, size_t thread_count, size_t entity_count,
+                std::chrono::microseconds interval) {
+        for (size_t t = 0; t < thread_count; ++t) {
+            producers.emplace_back([this, &queue, t, entity_count, interval]() {
+                std::mt19937 rng(static_cast<uint32_t>(1000 + t));
+                std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+                std::uniform_real_distribution<float> level(0.0f, 1.0f);
+                while (!stopping.load(std::memory_order_relaxed)) {
+                    const EntityID entity = static_cast<EntityID>(rng() % entity_count);
+                    const uint32_t roll = rng() % 20;
+                    if (roll == 0) {
+                        queue.Push(Commands::Command::Spawn(position(rng), position(rng)));
+                    } else if (roll < 10) {
+                        queue.Push(Commands::Command::Teleport(entity, position(rng), position(rng)));
+                    } else {
+                        const auto need = static_cast<Commands::Need>(rng() % 4);
+                        queue.Push(Commands::Command::SetNeed(entity, need, level(rng)));
+                    }
+                    std::this_thread::sleep_for(interval);
+                }
+            });
+        }
+    }
+    
+    ~CommandFeed() {
+        stopping.store(true);
+        for (std::thread& producer : producers) producer.join();
+    }
+    
+private:
+    std::atomic<bool> stopping{false};
+    std::vector<std::thread> producers;
+};
+
 int main(int argc, char* argv[]) {
     std::cout << "==================================================" << std::endl;
     std::cout << "  DATA-ORIENTED DESIGN AGENT SYSTEM" << std::endl;
@@ -106,23 +208,460 @@ int main(int argc, char* argv[]) {
     const size_t ENTITY_COUNT = 1000;
     const int SIMULATION_FRAMES = 100;
     const float DELTA_TIME = 0.016f; // ~60 FPS
+    const bool REAL_TIME_PACING = true;    // One tick per DELTA_TIME of wall time, sleeping in between
+    const uint32_t MAX_CATCH_UP_TICKS = 4; // Overdue ticks run back to back before the rest are dropped
     const bool ENABLE_CHAOS = false; // Set to true to test resilience
     const bool ENABLE_LOGGING = true;
     const bool ENABLE_PROFILING = true;
+    const uint32_t PERCEPTION_SLICES = 1; // Re-perceive 1/N of entities per frame
+    const uint32_t UTILITY_SLICES = 1;    // Re-decide 1/N of entities per frame
+    const bool ENABLE_LOD = true;         // Coarser ticks far from regions of interest
+    const bool ENABLE_BUDGET_CONTROL = true; // Adapt slicing/LOD to the budget (needs profiling)
+    const double FRAME_BUDGET_MS = 16.0;
+    const bool ENABLE_FUSION = true;      // Fused Needs+Utility pass (needs lag one frame)
+    const size_t THREAD_COUNT = 0;        // Job system threads incl. main (0 = hardware concurrency)
+    const bool VALIDATE_SIMD = false;     // Debug: SIMD kinetics vs scalar every 10 frames (--validate-simd)
+    const bool ENABLE_SEPARATION = true;  // Agents push apart instead of overlapping
+    const bool ENABLE_FLOW_FIELDS = true; // Shared steering toward popular goals
+    const bool ENABLE_REVERSE_VISIBILITY = true; // "Who sees me" index after perception
+    const bool ENABLE_VISIBILITY_EVENTS = true;  // Enter/exit events instead of full sets
+    const int WALL_COUNT = 60;            // Static obstacle walls (0 = open world)
+    const bool ENABLE_PATHFINDING = true; // Route seekers around walls
+    const float PATH_BUDGET_MS = 1.0f;    // Pathfinding time per frame
+    const bool ENABLE_DIAGNOSTICS_PIPELINE = true; // Log/validate/stats on a background thread
+    const size_t DIAGNOSTICS_DEPTH = 2;   // Snapshots in flight before the simulation waits
+    // Components written for frame N+1 while N is read; adding ACTIONS makes
+    // decisions take effect one frame later
+    const ComponentMask DOUBLE_BUFFERED = Component::TRANSFORMS;
+    // Same frames for any thread count: fixed pathfinding work per frame
+    // instead of a time budget, no budget control, and a logged per-frame
+    // state checksum. Also enabled by --deterministic or --verify.
+    const bool DETERMINISTIC = false;
+    const uint32_t DETERMINISTIC_PATH_BATCHES = 4; // Pathfinding batches per frame
+    const uint64_t RANDOM_SEED = 1;
+    // --worlds N: N independent worlds (seeds 42.., RANDOM_SEED..) on one
+    // job system instead of the single simulation, with aggregate results
+    const size_t WORLD_ENTITY_COUNT = 250;
+    const size_t WORLD_BATCH_ENTITIES = 4096; // Smaller worlds share a job up to this many entities
+    // --shards S: the world cut into S vertical strips, one process each,
+    // trading border ghosts and migrants through shared memory
+    const float GHOST_RANGE = 100.0f; // Border band mirrored to the neighbour (>= longest view range)
+    // Worker placement: pin each worker to one CPU, have pinned workers
+    // prefer memory on their CPU's NUMA node, and always give chunk c of a
+    // parallel loop to worker 1 + c % workers so its SoA slice stays in that
+    // core's cache. Also --pin, --numa, --stable-chunks.
+    const bool PIN_WORKERS = false;
+    const bool BIND_NUMA = false;
+    const bool STABLE_CHUNKS = false;
+    const int AFFINITY_BENCH_FRAMES = 200; // --affinity-bench: timed frames per placement
+    // External commands are drained into the state at the start of each
+    // frame. --command-feed starts producer threads posting random ones.
+    const size_t COMMAND_QUEUE_CAPACITY = 1024;
+    const size_t MAX_ENTITIES = 4 * ENTITY_COUNT; // Spawns beyond this are rejected
+    const size_t COMMAND_FEED_THREADS = 2;
+    const auto COMMAND_FEED_INTERVAL = std::chrono::microseconds(200); // Per producer, between commands
+    
+    // Command line: --threads N, --seed N, --deterministic, --verify <log>
+    // (replay against the checksums of an earlier deterministic run),
+    // --unpaced (ticks back to back, for benchmarks), --worlds N, --shards S,
+    // --pin, --numa, --stable-chunks, --affinity-bench (every placement, timed),
+    // --command-feed, --validate-simd
+    size_t thread_count = THREAD_COUNT;
+    size_t world_count = 0;
+    size_t shard_count = 1;
+    bool paced = REAL_TIME_PACING;
+    uint64_t random_seed = RANDOM_SEED;
+    bool deterministic = DETERMINISTIC;
+    std::string verify_path;
+    Parallel::Affinity affinity;
+    affinity.pin_workers = PIN_WORKERS || BIND_NUMA;
+    affinity.bind_numa = BIND_NUMA;
+    affinity.stable_chunks = STABLE_CHUNKS;
+    bool affinity_bench = false;
+    bool command_feed = false;
+    bool validate_simd = VALIDATE_SIMD;
+    for (int arg = 1; arg < argc; ++arg) {
+        const std::string option = argv[arg];
+        const bool has_value = arg + 1 < argc;
+        if (option == "--threads" && has_value) {
+            thread_count = std::stoul(argv[++arg]);
+        } else if (option == "--seed" && has_value) {
+            random_seed = std::stoull(argv[++arg]);
+        } else if (option == "--shards" && has_value) {
+            shard_count = std::max<size_t>(1, std::stoul(argv[++arg]));
+        } else if (option == "--worlds" && has_value) {
+            world_count = std::stoul(argv[++arg]);
+        } else if (option == "--unpaced") {
+            paced = false;
+        } else if (option == "--pin") {
+            affinity.pin_workers = true;
+        } else if (option == "--numa") {
+            affinity.pin_workers = true;
+            affinity.bind_numa = true;
+        } else if (option == "--stable-chunks") {
+            affinity.stable_chunks = true;
+        } else if (option == "--affinity-bench") {
+            affinity_bench = true;
+        } else if (option == "--command-feed") {
+            command_feed = true;
+        } else if (option == "--validate-simd") {
+            validate_simd = true;
+        } else if (option == "--deterministic") {
+            deterministic = true;
+        } else if (option == "--verify" && has_value) {
+            verify_path = argv[++arg];
+            deterministic = true;
+        } else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+    
+    // Read before the logger below truncates simulation_log.bin
+    std::vector<uint64_t> reference;
+    if (!verify_path.empty()) {
+        reference = Diagnostics::StateLogger::ReadChecksums(verify_path);
+        if (reference.empty()) {
+            std::cerr << "No checksums found in " << verify_path << std::endl;
+            return 1;
+        }
+    }
+    if (command_feed && deterministic) {
+        std::cerr << "--command-feed posts commands in real time, so it cannot be deterministic" << std::endl;
+        return 1;
+    }
+    const bool budget_control = ENABLE_BUDGET_CONTROL && ENABLE_PROFILING && !deterministic;
+    
+    // ========================================================================
+    // HEADLESS SETUP - The simulation without diagnostics, for the
+    // multi-world and sharded modes below
+    // ========================================================================
+    
+    auto set_up_headless = [&](GameState& ws, size_t count, uint32_t entity_seed, uint64_t rng_seed) {
+        InitializeEntities(ws, count, WALL_COUNT, entity_seed);
+        ws.random_seed = rng_seed;
+        // Cores are shared, so a time budget would make results load-dependent
+        ws.pathfinding.frame_batch_limit = DETERMINISTIC_PATH_BATCHES;
+        ws.EnableDoubleBuffering(DOUBLE_BUFFERED);
+        ws.stimulus_buffer.build_reverse_index = ENABLE_REVERSE_VISIBILITY;
+        ws.stimulus_buffer.build_visibility_events = ENABLE_VISIBILITY_EVENTS;
+        if (ENABLE_PATHFINDING) Systems::PathSystem::RebuildNavigation(ws);
+        if (ENABLE_LOD) ws.regions_of_interest.push_back({500.0f, 500.0f, 150.0f});
+    };
+    
+    auto add_headless_systems = [&](Scheduling::SystemScheduler& ss, GameState& ws) {
+        ss.SetDoubleBuffered(ws.double_buffered);
+        ss.AddSystem<Systems::PerceptionSystem>("PerceptionSystem", ws, DELTA_TIME);
+        ss.AddSystem<Systems::LODSystem>("LODSystem", ws, DELTA_TIME);
+        ss.AddSystem<Systems::InfluenceSystem>("InfluenceSystem", ws, DELTA_TIME);
+        if (ENABLE_FUSION) {
+            ss.AddSystem<Systems::NeedsUtilitySystem>("NeedsUtilitySystem", ws, DELTA_TIME);
+        } else {
+            ss.AddSystem<Systems::UtilitySystem>("UtilitySystem", ws, DELTA_TIME);
+        }
+        if (ENABLE_FLOW_FIELDS) ss.AddSystem<Systems::FlowFieldSystem>("FlowFieldSystem", ws, DELTA_TIME);
+        if (ENABLE_PATHFINDING) ss.AddSystem<Systems::PathSystem>("PathSystem", ws, DELTA_TIME);
+        if (ENABLE_SEPARATION) ss.AddSystem<Systems::SeparationSystem>("SeparationSystem", ws, DELTA_TIME);
+        ss.AddSystem<Systems::KineticSystem>("KineticSystem", ws, DELTA_TIME);
+        if (!ENABLE_FUSION) ss.AddSystem<Systems::NeedsSystem>("NeedsSystem", ws, DELTA_TIME);
+        if (ws.double_buffered != Component::NONE) {
+            const ComponentMask buffers = ws.double_buffered |
+                Component::RedirectWrites(ws.double_buffered, ws.double_buffered);
+            ss.Add("SwapBuffers", buffers, buffers, [&ws]() { ws.SwapBuffers(); });
+        }
+    };
+    
+    // ========================================================================
+    // SHARDED MODE - One world, one process per strip
+    // Processes fork before any job system thread exists.
+    // ========================================================================
+    
+    if (shard_count > 1) {
+        Sharding::Layout layout;
+        layout.shard_count = shard_count;
+        layout.ghost_range = GHOST_RANGE;
+        if (layout.StripWidth() < layout.ghost_range) {
+            // Ghosts only reach the adjacent strip, so a narrower strip would
+            // hide entities two strips away that are still in view range
+            std::cerr << "--shards " << shard_count << " makes strips " << layout.StripWidth()
+                      << " wide, narrower than the ghost band " << GHOST_RANGE << "; use at most "
+                      << static_cast<size_t>(layout.world_width / layout.ghost_range) << " shards" << std::endl;
+            return 1;
+        }
+        // A ring may hold two frames' worth of records before it is drained
+        uint64_t capacity = 1;
+        while (capacity < 2 * (ENTITY_COUNT + 1)) capacity <<= 1;
+        Sharding::SharedRegion region("/dod_shards_" + std::to_string(getpid()), shard_count, capacity);
+        
+        std::cout << "Shards: " << shard_count << " processes, strips " << layout.StripWidth()
+                  << " wide, ghost band " << GHOST_RANGE << std::endl;
+        std::cout << std::flush;
+        size_t shard_index = 0;
+        std::vector<pid_t> children;
+        for (size_t k = 1; k < shard_count; ++k) {
+            pid_t pid = fork();
+            if (pid < 0) {
+                std::cerr << "fork failed" << std::endl;
+                return 1;
+            }
+            if (pid == 0) {
+                shard_index = k;
+                children.clear();
+                break;
+            }
+            children.push_back(pid);
+        }
+        
+        // Every process: simulate its strip in lockstep with its neighbours
+        Sharding::ShardReport& report = region.Report(shard_index);
+        try {
+            const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+            Parallel::Affinity shard_affinity = affinity;
+            if (shard_affinity.pin_workers) {
+                // Each shard pins to its own slice of the CPUs
+                const std::vector<int> cpus = Parallel::AvailableCpus();
+                const size_t per_shard = std::max<size_t>(1, cpus.size() / shard_count);
+                for (size_t c = 0; c < per_shard; ++c) {
+                    shard_affinity.cpus.push_back(cpus[(shard_index * per_shard + c) % cpus.size()]);
+                }
+            }
+            Parallel::Configure(thread_count ? thread_count : std::max<size_t>(1, cores / shard_count), shard_affinity);
+            
+            GameState ws;
+            set_up_headless(ws, ENTITY_COUNT, 42, random_seed);
+            ws.stimulus_buffer.build_visibility_events = false; // Rows renumber every frame
+            Sharding::Shard shard(ws, layout, shard_index, region);
+            shard.Claim();
+            Scheduling::SystemScheduler ss;
+            add_headless_systems(ss, ws);
+            
+            auto shard_start = std::chrono::high_resolution_clock::now();
+            for (int f = 0; f < SIMULATION_FRAMES; ++f) {
+                shard.Exchange(static_cast<uint32_t>(f));
+                // Every row index must survive the renumbering
+                if (!Diagnostics::SystemValidator::ValidateState(ws)) {
+                    throw std::runtime_error("state invalid after exchange at frame " + std::to_string(f));
+                }
+                ss.Run();
+                ws.frame_index++;
+            }
+            ss.Finish();
+            shard.DropGhosts();
+            
+            report.frame_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - shard_start).count() / SIMULATION_FRAMES;
+            report.owned = shard.Owned();
+            for (EntityID i = 0; i < ws.entity_count; ++i) report.alive += ws.health.is_alive[i] ? 1 : 0;
+            report.migrated_in = shard.GetStats().migrated_in;
+            report.migrated_out = shard.GetStats().migrated_out;
+            report.ghosts_received = shard.GetStats().ghosts_received;
+            const std::vector<uint32_t>& ids = shard.GlobalIds();
+            report.checksum = Determinism::Hash64(ids.data(), ids.size() * sizeof(uint32_t),
+                                                  Determinism::StateChecksum(ws));
+            report.status = 0;
+        } catch (const std::exception& error) {
+            std::cerr << "Shard " << shard_index << ": " << error.what() << std::endl;
+            report.status = 1;
+        }
+        if (shard_index != 0) _exit(report.status);
+        
+        bool ok = report.status == 0;
+        for (pid_t child : children) {
+            int status = 0;
+            waitpid(child, &status, 0);
+            ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        region.Unlink();
+        
+        uint64_t owned = 0;
+        uint64_t combined = 0;
+        for (size_t k = 0; k < shard_count; ++k) {
+            const Sharding::ShardReport& r = region.Report(k);
+            std::cout << "Shard " << k << ": owned " << r.owned << " | alive " << r.alive
+                      << " | migrated in/out " << r.migrated_in << "/" << r.migrated_out
+                      << " | ghosts/frame " << r.ghosts_received / SIMULATION_FRAMES
+                      << " | " << r.frame_ms << " ms/frame" << std::endl;
+            owned += r.owned;
+            combined = Determinism::Hash64(&r.checksum, sizeof(r.checksum), combined);
+        }
+        std::cout << "Entities owned: " << owned << "/" << ENTITY_COUNT << std::endl;
+        std::cout << "Sharded checksum: 0x" << std::hex << std::setw(16) << std::setfill('0')
+                  << combined << std::dec << std::setfill(' ') << std::endl;
+        if (!ok || owned != ENTITY_COUNT) {
+            std::cerr << "Sharded run failed" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    
+    Parallel::Configure(thread_count, affinity);
+    
+    // ========================================================================
+    // AFFINITY BENCHMARK - The same headless frames under each placement
+    // ========================================================================
+    
+    if (affinity_bench) {
+        struct Placement {
+            const char* name;
+            bool pin;
+            bool numa;
+            bool stable;
+        };
+        const Placement placements[] = {
+            {"work stealing", false, false, false},
+            {"stable chunks", false, false, true},
+            {"stable chunks + pinned", true, false, true},
+            {"stable chunks + pinned + NUMA", true, true, true},
+        };
+        std::cout << "Affinity benchmark: " << ENTITY_COUNT << " entities, " << AFFINITY_BENCH_FRAMES
+                  << " frames per placement" << std::endl;
+        for (const Placement& placement : placements) {
+            Parallel::Affinity config;
+            config.pin_workers = placement.pin;
+            config.bind_numa = placement.numa;
+            config.stable_chunks = placement.stable;
+            Parallel::Configure(thread_count, config);
+            
+            GameState ws;
+            set_up_headless(ws, ENTITY_COUNT, 42, random_seed);
+            const size_t placed = Systems::KineticSystem::PlaceRows(ws);
+            Scheduling::SystemScheduler ss;
+            add_headless_systems(ss, ws);
+            for (int f = 0; f < 10; ++f) { // Warm caches and page in the arrays
+                ss.Run();
+                ws.frame_index++;
+            }
+            auto bench_start = std::chrono::high_resolution_clock::now();
+            for (int f = 0; f < AFFINITY_BENCH_FRAMES; ++f) {
+                ss.Run();
+                ws.frame_index++;
+            }
+            ss.Finish();
+            double bench_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - bench_start).count();
+            
+            const Parallel::JobSystem& pool = Parallel::Pool();
+            std::cout << "  " << std::left << std::setw(32) << placement.name << std::right
+                      << bench_ms / AFFINITY_BENCH_FRAMES << " ms/frame | pinned "
+                      << pool.PinnedWorkers() << "/" << pool.ThreadCount() - 1 << " workers, NUMA-bound "
+                      << pool.BoundWorkers() << ", chunks placed " << placed
+                      << " | checksum 0x" << std::hex << std::setw(16) << std::setfill('0')
+                      << Determinism::StateChecksum(ws) << std::dec << std::setfill(' ') << std::endl;
+        }
+        return 0;
+    }
+    
+    // ========================================================================
+    // MULTI-WORLD MODE - Many small simulations, one job system
+    // ========================================================================
+    
+    if (world_count > 0) {
+        Worlds::WorldRunner runner(WORLD_BATCH_ENTITIES);
+        for (size_t w = 0; w < world_count; ++w) {
+            runner.AddWorld([&](Worlds::World& world) {
+                set_up_headless(world.state, WORLD_ENTITY_COUNT, static_cast<uint32_t>(42 + w), random_seed + w);
+                add_headless_systems(world.scheduler, world.state);
+            });
+        }
+        
+        std::cout << "Worlds: " << runner.WorldCount() << " x " << WORLD_ENTITY_COUNT << " entities in "
+                  << runner.BatchCount() << " batches on " << Parallel::ThreadCount() << " threads" << std::endl;
+        auto worlds_start = std::chrono::high_resolution_clock::now();
+        for (int f = 0; f < SIMULATION_FRAMES; ++f) runner.Step();
+        runner.Finish();
+        double worlds_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - worlds_start).count();
+        
+        const Worlds::Summary total = runner.Aggregate(DELTA_TIME);
+        std::cout << "Frames: " << SIMULATION_FRAMES << " in " << worlds_ms << " ms ("
+                  << worlds_ms / SIMULATION_FRAMES << " ms/frame for all worlds)" << std::endl;
+        std::cout << "Alive: " << total.alive << "/" << total.entities << std::endl;
+        const char* action_names[] = {"Idle", "Move", "Eat", "Sleep", "Flee", "Attack", "Explore"};
+        static_assert(sizeof(action_names) / sizeof(action_names[0]) == static_cast<size_t>(ActionType::COUNT),
+                      "One name per action");
+        std::cout << "Actions -";
+        for (size_t a = 0; a < static_cast<size_t>(ActionType::COUNT); ++a) {
+            std::cout << (a ? " |" : "") << " " << action_names[a] << ": " << total.actions[a];
+        }
+        std::cout << std::endl;
+        std::cout << "Mean hunger: " << total.MeanHunger() << " | mean energy: " << total.MeanEnergy() << std::endl;
+        return 0;
+    }
     
     // Initialize game state
     GameState state;
-    InitializeEntities(state, ENTITY_COUNT);
+    InitializeEntities(state, ENTITY_COUNT, WALL_COUNT);
+    std::cout << "Initialized " << ENTITY_COUNT << " entities" << std::endl;
+    state.pathfinding.frame_budget_ms = PATH_BUDGET_MS;
+    state.random_seed = random_seed;
+    if (deterministic) state.pathfinding.frame_batch_limit = DETERMINISTIC_PATH_BATCHES;
+    state.EnableDoubleBuffering(DOUBLE_BUFFERED);
+    state.stimulus_buffer.build_reverse_index = ENABLE_REVERSE_VISIBILITY;
+    state.stimulus_buffer.build_visibility_events = ENABLE_VISIBILITY_EVENTS;
+    if (ENABLE_PATHFINDING) Systems::PathSystem::RebuildNavigation(state);
+    const size_t placed_chunks = Systems::KineticSystem::PlaceRows(state); // NUMA: chunks to their workers' nodes
+    state.scheduling.perception_slices = PERCEPTION_SLICES;
+    state.scheduling.utility_slices = UTILITY_SLICES;
+    if (ENABLE_LOD) {
+        // Stand-in for player positions: one region in the middle of the world
+        state.regions_of_interest.push_back({500.0f, 500.0f, 150.0f});
+    }
     
     // Initialize diagnostics
     Diagnostics::StateLogger logger("simulation_log.bin");
     Diagnostics::ChaosMonkey chaos(0.001f, ENABLE_CHAOS);
     Diagnostics::Profiler profiler;
+    Diagnostics::FrameBudgetController budget(FRAME_BUDGET_MS, ENABLE_LOGGING ? &logger : nullptr);
     
     std::cout << "\nStarting simulation with " << ENTITY_COUNT << " entities..." << std::endl;
     std::cout << "Chaos Monkey: " << (ENABLE_CHAOS ? "ENABLED" : "DISABLED") << std::endl;
     std::cout << "Logging: " << (ENABLE_LOGGING ? "ENABLED" : "DISABLED") << std::endl;
     std::cout << "Profiling: " << (ENABLE_PROFILING ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Time slicing: perception 1/" << PERCEPTION_SLICES
+              << ", utility 1/" << UTILITY_SLICES << std::endl;
+    std::cout << "LOD: " << (ENABLE_LOD ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Real-Time Pacing: " << (paced ? "ENABLED" : "DISABLED")
+              << " (" << 1.0f / DELTA_TIME << " Hz, catch-up " << MAX_CATCH_UP_TICKS << " ticks)" << std::endl;
+#if defined(__AVX2__)
+    std::cout << "Kinetic Kernel: AVX2 (" << (Systems::KineticSystem::FAST_MATH ? "fast" : "exact") << " math)" << std::endl;
+#else
+    std::cout << "Kinetic Kernel: scalar" << std::endl;
+#endif
+    std::cout << "SIMD Validation: " << (validate_simd ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Job System: " << Parallel::ThreadCount() << " threads";
+    if (affinity.pin_workers) {
+        std::cout << " (" << Parallel::Pool().PinnedWorkers() << " workers pinned";
+        if (affinity.bind_numa) {
+            std::cout << ", " << Parallel::Pool().BoundWorkers() << " NUMA-bound, " << placed_chunks << " chunks placed";
+        }
+        std::cout << ")";
+    }
+    std::cout << (affinity.stable_chunks ? ", stable chunks" : "") << std::endl;
+    std::cout << "Separation: " << (ENABLE_SEPARATION ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Flow Fields: " << (ENABLE_FLOW_FIELDS ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Reverse Visibility: " << (ENABLE_REVERSE_VISIBILITY ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Visibility Events: " << (ENABLE_VISIBILITY_EVENTS ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Obstacles: " << state.obstacles.blocked_count << " blocked cells" << std::endl;
+    std::cout << "Pathfinding: " << (ENABLE_PATHFINDING ? "ENABLED" : "DISABLED");
+    if (deterministic) {
+        std::cout << " (" << DETERMINISTIC_PATH_BATCHES << " batches/frame)" << std::endl;
+    } else {
+        std::cout << " (" << PATH_BUDGET_MS << " ms/frame)" << std::endl;
+    }
+    std::cout << "Diagnostics Pipeline: " << (ENABLE_DIAGNOSTICS_PIPELINE ? "ENABLED" : "DISABLED")
+              << " (depth " << DIAGNOSTICS_DEPTH << ")" << std::endl;
+    std::cout << "Double Buffering:"
+              << (DOUBLE_BUFFERED & Component::TRANSFORMS ? " transforms" : "")
+              << (DOUBLE_BUFFERED & Component::ACTIONS ? " actions" : "")
+              << (DOUBLE_BUFFERED == Component::NONE ? " DISABLED" : "") << std::endl;
+    std::cout << "System Fusion: " << (ENABLE_FUSION ? "ENABLED" : "DISABLED") << std::endl;
+    std::cout << "Budget Control: " << (budget_control ? "ENABLED" : "DISABLED")
+              << " (" << FRAME_BUDGET_MS << " ms)" << std::endl;
+    std::cout << "Determinism: " << (deterministic ? "ENABLED" : "DISABLED")
+              << " (seed " << random_seed << ")" << std::endl;
+    if (!verify_path.empty()) {
+        std::cout << "Verifying against: " << verify_path << " (" << reference.size() << " frames)" << std::endl;
+    }
     
     // Validate initial state
     if (!Diagnostics::SystemValidator::ValidateState(state)) {
@@ -134,76 +673,234 @@ int main(int argc, char* argv[]) {
     Diagnostics::SystemValidator::PrintStateSnapshot(state, 0);
     
     // ========================================================================
-    // THE MAIN LOOP - Linear pipeline execution
+    // THE SCHEDULE - Systems in program order; the masks decide what overlaps
+    // ========================================================================
+    
+    // Per-frame checksums (deterministic mode), logged ahead of their frame
+    // and compared with the reference run's
+    std::vector<uint64_t> checksums(SIMULATION_FRAMES, 0);
+    std::atomic<int> diverged_frame{-1}; // First frame that differs from the reference
+    auto record_checksum = [&](int logged_frame, uint64_t checksum) {
+        checksums[logged_frame] = checksum;
+        if (ENABLE_LOGGING) logger.LogChecksum(checksum);
+        const size_t index = static_cast<size_t>(logged_frame);
+        if (index < reference.size() && reference[index] != 0 && reference[index] != checksum) {
+            int none = -1;
+            diverged_frame.compare_exchange_strong(none, logged_frame);
+        }
+    };
+    auto report_divergence = [&]() {
+        const int bad = diverged_frame.load();
+        std::cerr << "Determinism check failed at frame " << bad << ": checksum 0x" << std::hex
+                  << checksums[bad] << ", reference 0x" << reference[bad] << std::dec << std::endl;
+    };
+    
+    int frame = 0;
+    Scheduling::SystemScheduler scheduler;
+    scheduler.SetDoubleBuffered(state.double_buffered);
+    
+    // External commands: first stage of the frame, after last frame's
+    // trailing stages and before any system
+    Commands::CommandQueue command_queue(COMMAND_QUEUE_CAPACITY);
+    Commands::CommandIngest ingest(MAX_ENTITIES, DELTA_TIME);
+    ingest.Attach(command_queue);
+    scheduler.Add("CommandIngest", Commands::CommandIngest::READS, Commands::CommandIngest::WRITES,
+        [&]() { ingest.Apply(state); });
+    
+    if ((ENABLE_LOGGING || deterministic) && !ENABLE_DIAGNOSTICS_PIPELINE) {
+        scheduler.AddTrailing("StateLogger",
+            Diagnostics::StateLogger::READS |
+                (ENABLE_VISIBILITY_EVENTS ? Diagnostics::StateLogger::VISIBILITY_READS : Component::NONE) |
+                (deterministic ? Determinism::CHECKSUM_READS : Component::NONE),
+            Component::NONE,
+            [&]() {
+                // Runs in the next frame, after frame_index moved on
+                if (deterministic) {
+                    record_checksum(static_cast<int>(state.frame_index) - 1, Determinism::StateChecksum(state));
+                }
+                if (!ENABLE_LOGGING) return;
+                if (ENABLE_VISIBILITY_EVENTS) logger.LogVisibilityChanges(state);
+                logger.LogFrame(state);
+            });
+    }
+    scheduler.AddSystem<Systems::PerceptionSystem>("PerceptionSystem", state, DELTA_TIME);
+    scheduler.AddSystem<Systems::LODSystem>("LODSystem", state, DELTA_TIME);
+    scheduler.AddSystem<Systems::InfluenceSystem>("InfluenceSystem", state, DELTA_TIME);
+    if (ENABLE_FUSION) {
+        scheduler.AddSystem<Systems::NeedsUtilitySystem>("NeedsUtilitySystem", state, DELTA_TIME);
+    } else {
+        scheduler.AddSystem<Systems::UtilitySystem>("UtilitySystem", state, DELTA_TIME);
+    }
+    if (ENABLE_FLOW_FIELDS) {
+        scheduler.AddSystem<Systems::FlowFieldSystem>("FlowFieldSystem", state, DELTA_TIME);
+    }
+    if (ENABLE_PATHFINDING) {
+        scheduler.AddSystem<Systems::PathSystem>("PathSystem", state, DELTA_TIME);
+    }
+    if (ENABLE_SEPARATION) {
+        scheduler.AddSystem<Systems::SeparationSystem>("SeparationSystem", state, DELTA_TIME);
+    }
+    
+#if defined(__AVX2__)
+    // Debug only: copies the whole state, so it reads every component and
+    // serializes the frame on the frames it runs
+    bool simd_diverged = false;
+    if (validate_simd) {
+        scheduler.Add("SimdValidation", ~Component::NONE, Scheduling::CONSOLE,
+            [&]() {
+                auto check = Systems::KineticSystem::CompareSimdWithScalar(state, DELTA_TIME);
+                std::cout << "[SIMD] Kinetic exact-mode mismatches: " << check.exact_mismatches
+                          << " | fast-mode max error: " << check.fast_max_error << std::endl;
+                simd_diverged = check.exact_mismatches != 0;
+            },
+            [&]() { return frame % 10 == 0; });
+    }
+#endif
+    
+    scheduler.AddSystem<Systems::KineticSystem>("KineticSystem", state, DELTA_TIME);
+    if (!ENABLE_FUSION) {
+        scheduler.AddSystem<Systems::NeedsSystem>("NeedsSystem", state, DELTA_TIME);
+    }
+    
+    // Publish frame N+1: waits for every reader and writer of either buffer
+    if (state.double_buffered != Component::NONE) {
+        const ComponentMask buffers = state.double_buffered |
+            Component::RedirectWrites(state.double_buffered, state.double_buffered);
+        scheduler.Add("SwapBuffers", buffers, buffers, [&]() { state.SwapBuffers(); });
+    }
+    
+    // Print stats every 10 frames
+    if (!ENABLE_DIAGNOSTICS_PIPELINE) {
+        scheduler.Add("SimulationStats", SIMULATION_STATS_READS, Scheduling::CONSOLE,
+            [&]() { PrintSimulationStats(state, frame); },
+            [&]() { return frame % 10 == 0; });
+    }
+    
+    // ========================================================================
+    // THE DIAGNOSTICS PIPELINE - Logging, validation and stats off the frame
+    // ========================================================================
+    
+    std::atomic<int> failed_frame{-1}; // First frame the background validation rejected
+    std::unique_ptr<Diagnostics::DiagnosticsPipeline> pipeline;
+    if (ENABLE_DIAGNOSTICS_PIPELINE) {
+        logger.SetDeferEvents(true);
+        pipeline = std::make_unique<Diagnostics::DiagnosticsPipeline>(DIAGNOSTICS_DEPTH,
+            [&](const Diagnostics::FrameSnapshot& snapshot) {
+                if (deterministic) record_checksum(snapshot.frame, Determinism::StateChecksum(snapshot.state));
+                if (ENABLE_LOGGING) {
+                    for (const auto& event : snapshot.events) logger.WriteEvent(event.name, event.entity);
+                    if (ENABLE_VISIBILITY_EVENTS) logger.LogVisibilityChanges(snapshot.state);
+                    logger.LogFrame(snapshot.state);
+                }
+                if (!Diagnostics::SystemValidator::ValidateState(snapshot.state)) {
+                    int none = -1;
+                    failed_frame.compare_exchange_strong(none, snapshot.frame);
+                }
+                if (snapshot.with_stats) {
+                    // A single write, so it never interleaves with the simulation thread
+                    std::ostringstream text;
+                    PrintSimulationStats(snapshot.state, snapshot.frame, text);
+                    text << snapshot.profile_report;
+                    std::cout << text.str() << std::flush;
+                }
+            });
+    }
+    
+    // ========================================================================
+    // THE MAIN LOOP - One scheduled frame, then the between-frame work
     // ========================================================================
     
     auto simulation_start = std::chrono::high_resolution_clock::now();
+    Scheduling::TickDriver ticks(DELTA_TIME, MAX_CATCH_UP_TICKS, paced);
+    std::unique_ptr<CommandFeed> feed;
+    if (command_feed) {
+        feed = std::make_unique<CommandFeed>(command_queue, COMMAND_FEED_THREADS, ENTITY_COUNT, COMMAND_FEED_INTERVAL);
+    }
     
-    for (int frame = 0; frame < SIMULATION_FRAMES; ++frame) {
+    for (frame = 0; frame < SIMULATION_FRAMES; ++frame) {
+        ticks.WaitForTick();
         if (ENABLE_PROFILING) profiler.Clear();
         
-        // System Pipeline
-        {
-            if (ENABLE_PROFILING) {
-                Diagnostics::ProfileScope scope(profiler, "PerceptionSystem");
-                Systems::PerceptionSystem::Update(state, DELTA_TIME);
-            } else {
-                Systems::PerceptionSystem::Update(state, DELTA_TIME);
-            }
+        const auto run_start = std::chrono::high_resolution_clock::now();
+        scheduler.Run(ENABLE_PROFILING ? &profiler : nullptr);
+        const double run_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - run_start).count();
+        if (ENABLE_PROFILING) {
+            ticks.Publish(profiler);
+            ingest.Publish(profiler);
         }
         
-        {
-            if (ENABLE_PROFILING) {
-                Diagnostics::ProfileScope scope(profiler, "UtilitySystem");
-                Systems::UtilitySystem::Update(state, DELTA_TIME);
-            } else {
-                Systems::UtilitySystem::Update(state, DELTA_TIME);
-            }
+#if defined(__AVX2__)
+        if (simd_diverged) {
+            std::cerr << "SIMD kinetic kernel diverged from scalar at frame " << frame << "!" << std::endl;
+            return 1;
         }
+#endif
         
-        {
-            if (ENABLE_PROFILING) {
-                Diagnostics::ProfileScope scope(profiler, "KineticSystem");
-                Systems::KineticSystem::Update(state, DELTA_TIME);
-            } else {
-                Systems::KineticSystem::Update(state, DELTA_TIME);
-            }
+        // Retune slicing/LOD from this frame's wall time before the next frame
+        if (budget_control) {
+            budget.Update(profiler, state, run_ms);
         }
         
-        {
-            if (ENABLE_PROFILING) {
-                Diagnostics::ProfileScope scope(profiler, "NeedsSystem");
-                Systems::NeedsSystem::Update(state, DELTA_TIME);
-            } else {
-                Systems::NeedsSystem::Update(state, DELTA_TIME);
-            }
-        }
+        state.frame_index++;
         
         // Chaos Monkey (if enabled)
         if (ENABLE_CHAOS) {
             chaos.MaybeCorrupt(state);
         }
         
-        // Validation
-        if (!Diagnostics::SystemValidator::ValidateState(state)) {
-            std::cerr << "State validation failed at frame " << frame << "!" << std::endl;
-            Diagnostics::SystemValidator::PrintStateSnapshot(state, 0);
-            return 1;
-        }
-        
-        // Logging
-        if (ENABLE_LOGGING) {
-            logger.LogFrame(state);
-        }
-        
-        // Print stats every 10 frames
-        if (frame % 10 == 0) {
-            PrintSimulationStats(state, frame);
+        if (ENABLE_DIAGNOSTICS_PIPELINE) {
+            // Snapshot the frame and move on; blocks only if the background
+            // stage is DIAGNOSTICS_DEPTH frames behind
+            Diagnostics::FrameSnapshot& snapshot = pipeline->Acquire();
+            snapshot.Capture(state, frame, frame % 10 == 0);
+            logger.TakeDeferredEvents(snapshot.events);
+            snapshot.profile_report.clear();
+            if (ENABLE_PROFILING && snapshot.with_stats) {
+                std::ostringstream report;
+                profiler.PrintReport(report);
+                snapshot.profile_report = report.str();
+            }
+            pipeline->Submit();
+            
+            // Background validation reports up to DIAGNOSTICS_DEPTH frames late
+            if (failed_frame.load() >= 0) {
+                std::cerr << "State validation failed at frame " << failed_frame.load() << "!" << std::endl;
+                Diagnostics::SystemValidator::PrintStateSnapshot(state, 0);
+                return 1;
+            }
+        } else {
+            // Validation
+            if (!Diagnostics::SystemValidator::ValidateState(state)) {
+                std::cerr << "State validation failed at frame " << frame << "!" << std::endl;
+                Diagnostics::SystemValidator::PrintStateSnapshot(state, 0);
+                return 1;
+            }
             
-            if (ENABLE_PROFILING) {
+            if (ENABLE_PROFILING && frame % 10 == 0) {
                 profiler.PrintReport();
             }
         }
+        
+        if (diverged_frame.load() >= 0) {
+            report_divergence();
+            return 1;
+        }
+    }
+    
+    // The last frame's logging is still pending
+    feed.reset();
+    scheduler.Finish();
+    if (ENABLE_DIAGNOSTICS_PIPELINE) {
+        pipeline->Drain();
+        if (failed_frame.load() >= 0) {
+            std::cerr << "State validation failed at frame " << failed_frame.load() << "!" << std::endl;
+            return 1;
+        }
+    }
+    if (diverged_frame.load() >= 0) {
+        report_divergence();
+        return 1;
     }
     
     auto simulation_end = std::chrono::high_resolution_clock::now();
@@ -220,8 +917,29 @@ int main(int argc, char* argv[]) {
     std::cout << "Average FPS: " << (SIMULATION_FRAMES * 1000.0f / total_duration.count()) << std::endl;
     std::cout << "Entities processed: " << ENTITY_COUNT << std::endl;
     std::cout << "Total entity-frames: " << (ENTITY_COUNT * SIMULATION_FRAMES) << std::endl;
+    if (ENABLE_DIAGNOSTICS_PIPELINE) {
+        std::cout << "Diagnostics stalls: " << pipeline->Stalls()
+                  << " (" << pipeline->StallMs() << " ms)" << std::endl;
+    }
+    std::cout << "Ticks caught up/dropped: " << ticks.GetStats().caught_up
+              << "/" << ticks.GetStats().dropped
+              << " | asleep: " << ticks.GetStats().sleep_ms << " ms" << std::endl;
+    const Commands::CommandIngest::Stats& commands = ingest.GetStats();
+    std::cout << "Commands: posted " << command_queue.Pushed() << " | applied " << commands.applied
+              << " (" << commands.spawned << " spawns) | rejected " << commands.rejected
+              << " | dropped " << ingest.Dropped() << " | max batch " << commands.max_batch << std::endl;
+    if (deterministic) {
+        size_t verified = 0;
+        for (size_t f = 0; f < checksums.size() && f < reference.size(); ++f) {
+            if (reference[f] != 0) verified++;
+        }
+        std::cout << "Final checksum: 0x" << std::hex << std::setw(16) << std::setfill('0')
+                  << checksums.back() << std::dec << std::setfill(' ') << std::endl;
+        std::cout << "Frames verified: " << verified << "/" << SIMULATION_FRAMES << std::endl;
+    }
     
-    // Print final snapshot
+    // Print final snapshot (settle lazily-updated needs first)
+    Systems::NeedsSystem::ResolveAll(state, state.frame_index - 1, DELTA_TIME);
     std::cout << "\nFinal state of entity 0:" << std::endl;
     Diagnostics::SystemValidator::PrintStateSnapshot(state, 0);
     